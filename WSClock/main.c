@@ -2,6 +2,32 @@
 #include <stdlib.h>
 #include <string.h>
 #include "wsclock_kernel.h"
+#include "wsclock_scanner.h"
+#include "wsclock_threads.h"
+#include "wsclock_timing.h"
+#include "wsclock_sched.h"
+#include "wsclock_sweep.h"
+#include "wsclock_shards.h"
+#include "wsclock_tier.h"
+#include "wsclock_shared.h"
+#include "wsclock_stats.h"
+#include "wsclock_series.h"
+#include "wsclock_arena.h"
+#include "wsclock_lifecycle.h"
+#include "wsclock_trace.h"
+#include "wsclock_renumber.h"
+#include "wsclock_idle.h"
+#include "wsclock_mglru.h"
+#include "wsclock_time.h"
+
+/* 每隔多少次访问完成一次对全部进程的引用位清理(默认值，可用 -s 修改) */
+#define SCAN_PERIOD 5
+
+/* 读取压缩引用序列时的解码线程数 */
+#define TRACE_DECODE_THREADS 4
+
+/* 空闲页跟踪估计模式的进程数(与演示环境相同，序列按轮转方式分配) */
+#define IDLE_PROCESSES 3
 
 /* 简单日志回调，用于演示打印 */
 static void demo_log(const char* msg)
@@ -11,16 +37,49 @@ static void demo_log(const char* msg)
     }
 }
 
+/* 读取压缩格式的引用序列(见 wsclock_trace.h)，各块并行解码 */
+static int* load_compressed_sequence(const char* filename, int* out_length)
+{
+    WSClockTrace trace;
+    *out_length = 0;
+    if (wsclock_trace_open(&trace, filename) != 0) {
+        printf("压缩引用序列格式错误: %s\n", filename);
+        return NULL;
+    }
+    int* arr = NULL;
+    if (trace.total_refs > 0 && trace.total_refs < 0x7fffffffLL) {
+        arr = (int*)malloc(sizeof(int) * (size_t)trace.total_refs);
+    }
+    if (arr && wsclock_trace_decode_all(&trace, arr, NULL, TRACE_DECODE_THREADS) == 0) {
+        *out_length = (int)trace.total_refs;
+    } else {
+        free(arr);
+        arr = NULL;
+    }
+    wsclock_trace_close(&trace);
+    return arr;
+}
+
 /* 读取某进程的页面访问序列(模拟或从文件加载) */
 static int* load_page_sequence(const char* filename, int* out_length)
 {
+    if (wsclock_trace_is_compressed(filename)) {
+        return load_compressed_sequence(filename, out_length);
+    }
     FILE* fp = fopen(filename, "r");
     if (!fp) {
         printf("无法打开文件: %s\n", filename);
         *out_length = 0;
         return NULL;
     }
+    /* 每个页号至少占2个字节(数字+分隔符)，按文件大小一次分配，读完后再收缩；
+       无法取得文件大小时(如管道)退回到倍增 */
     int capacity = 128;
+    if (fseek(fp, 0, SEEK_END) == 0) {
+        long size = ftell(fp);
+        if (size > 0 && size / 2 + 1 < 0x7fffffffL) capacity = (int)(size / 2 + 1);
+        rewind(fp);
+    }
     int count = 0;
     int* arr = (int*)malloc(sizeof(int) * capacity);
     if (!arr) {
@@ -44,43 +103,982 @@ static int* load_page_sequence(const char* filename, int* out_length)
         }
     }
     fclose(fp);
+    if (count > 0 && count < capacity) {
+        int* shrunk = (int*)realloc(arr, sizeof(int) * (size_t)count);
+        if (shrunk) arr = shrunk;
+    }
     *out_length = count;
     return arr;
 }
 
-int main()
+/* 文件大小(字节)，无法取得时为 -1 */
+static long file_size_of(const char* path)
 {
-    /* 假设系统中有3个进程 */
-    int process_count = 3;
-    Process* allProcs = (Process*)malloc(sizeof(Process)*process_count);
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return -1;
+    long size = fseek(fp, 0, SEEK_END) == 0 ? ftell(fp) : -1;
+    fclose(fp);
+    return size;
+}
 
-    /* 初始化各进程的页表与工作集大小(示例数值) */
-    for(int i=0; i<process_count; i++){
-        allProcs[i].process_id = i;
-        allProcs[i].page_count = 6;          /* 每个进程6页 */
-        allProcs[i].working_set_size = 3;    /* 工作集容量3 */
-        allProcs[i].clock = 0;
-        allProcs[i].active = 1;             /* 激活状态 */
-        allProcs[i].page_table = (Page*)malloc(sizeof(Page)*allProcs[i].page_count);
+/*
+ * 把引用序列转换为压缩格式(按 streams 个进程轮转划分做差分)，
+ * 并比较两种格式的文件大小、读取时间与解码吞吐量
+ */
+static int run_compress(const char* input, const char* output, const int* sequence, int seq_length,
+                        int streams, int threads)
+{
+    size_t bytes = 0;
+    unsigned long long t0 = wsclock_now_ns();
+    if (wsclock_trace_write(output, sequence, NULL, seq_length, streams, 0, &bytes) != 0) {
+        printf("压缩序列写入失败: %s\n", output);
+        return 1;
+    }
+    unsigned long long encode_ns = wsclock_now_ns() - t0;
+
+    /* 原格式的读取时间 */
+    int text_length = 0;
+    t0 = wsclock_now_ns();
+    int* text = load_page_sequence(input, &text_length);
+    unsigned long long text_ns = wsclock_now_ns() - t0;
+    free(text);
+
+    /* 读取文件：只计 I/O，不解码 */
+    WSClockTrace trace;
+    t0 = wsclock_now_ns();
+    if (wsclock_trace_open(&trace, output) != 0) {
+        printf("压缩序列读取失败: %s\n", output);
+        return 1;
+    }
+    unsigned long long open_ns = wsclock_now_ns() - t0;
+
+    int* decoded = (int*)malloc(sizeof(int) * (size_t)(seq_length > 0 ? seq_length : 1));
+    if (!decoded) {
+        wsclock_trace_close(&trace);
+        return 1;
+    }
+    t0 = wsclock_now_ns();
+    int rc = wsclock_trace_decode_all(&trace, decoded, NULL, 1);
+    unsigned long long single_ns = wsclock_now_ns() - t0;
+    t0 = wsclock_now_ns();
+    rc |= wsclock_trace_decode_all(&trace, decoded, NULL, threads);
+    unsigned long long parallel_ns = wsclock_now_ns() - t0;
+    int same = rc == 0 && memcmp(decoded, sequence, sizeof(int) * (size_t)seq_length) == 0;
+
+    /* 随机定位：从序列中部读一段，与原序列比较 */
+    long long mid = seq_length / 2;
+    long long got = wsclock_trace_read(&trace, mid, 1000, decoded, NULL);
+    same = same && got >= 0 && memcmp(decoded, sequence + mid, sizeof(int) * (size_t)got) == 0;
+
+    long text_bytes = file_size_of(input);
+    printf("压缩引用序列: %d 条引用, %d 个流, %d 块(每块 %d 条)\n",
+           seq_length, streams, trace.block_count, trace.block_refs);
+    printf("  %-12s %12s %10s %12s\n", "format", "bytes", "bytes/ref", "load_ms");
+    printf("  %-12s %12ld %10.2f %12.2f\n", "text", text_bytes,
+           seq_length ? (double)text_bytes / seq_length : 0.0, (double)text_ns / 1e6);
+    printf("  %-12s %12zu %10.2f %12.2f\n", "compressed", bytes,
+           seq_length ? (double)bytes / seq_length : 0.0, (double)(open_ns + parallel_ns) / 1e6);
+    printf("  压缩比 %.1fx, 编码 %.2f ms, 读取文件 %.2f ms\n",
+           bytes ? (double)text_bytes / (double)bytes : 0.0, (double)encode_ns / 1e6, (double)open_ns / 1e6);
+    printf("  解码吞吐量: 1 线程 %.0f 万条/秒, %d 线程 %.0f 万条/秒\n",
+           single_ns ? seq_length / ((double)single_ns / 1e9) / 1e4 : 0.0, threads,
+           parallel_ns ? seq_length / ((double)parallel_ns / 1e9) / 1e4 : 0.0);
+    printf("  解码结果%s\n", same ? "与原序列一致" : "与原序列不一致");
+    free(decoded);
+    wsclock_trace_close(&trace);
+    return same ? 0 : 1;
+}
+
+/*
+ * 按写访问比例决定第 index 次访问是否为写(对序号做整数哈希，结果可复现)
+ */
+static int is_write_ref(int index, int write_pct)
+{
+    if (write_pct <= 0) return 0;
+    unsigned int h = (unsigned int)index * 2654435761u;
+    h ^= h >> 16;
+    h *= 0x45d9f3bu;
+    h ^= h >> 16;
+    return (int)(h % 100u) < write_pct;
+}
+
+/*
+ * 参数扫描：展开网格，在线程池上运行，输出 CSV(默认) 或 JSON(输出文件名以 .json 结尾)
+ */
+static int run_sweep(const char* spec, const char* output, int threads,
+                     const int* sequence, int seq_length,
+                     int page_count, int working_set_size, int scan_period,
+                     int write_pct, const WSClockTimingConfig* timing)
+{
+    WSClockSweepPoint defaults;
+    memset(&defaults, 0, sizeof(defaults));
+    defaults.process_count = 3;
+    defaults.page_count = page_count;
+    defaults.working_set_size = working_set_size;
+    defaults.scan_period = scan_period;
+
+    WSClockSweepGrid* grid = (WSClockSweepGrid*)malloc(sizeof(WSClockSweepGrid));
+    if (!grid || wsclock_sweep_parse(spec, &defaults, grid) != 0) {
+        printf("无法解析扫描网格: %s\n", spec);
+        free(grid);
+        return 1;
+    }
+    WSClockSweepPoint* points = NULL;
+    int count = wsclock_sweep_expand(grid, &points);
+    free(grid);
+    if (count <= 0) {
+        printf("扫描网格为空或过大\n");
+        return 1;
+    }
 
-        for(int j=0; j<allProcs[i].page_count; j++){
-            allProcs[i].page_table[j].page_id = j;
-            allProcs[i].page_table[j].referenced = 0;
-            allProcs[i].page_table[j].modified = 0;
-            allProcs[i].page_table[j].age = 0;
-            allProcs[i].page_table[j].in_working_set = 0;
+    /* 写访问标记只计算一次，所有配置共享 */
+    unsigned char* writes = NULL;
+    if (write_pct > 0) {
+        writes = (unsigned char*)malloc((size_t)seq_length);
+        for (int i = 0; writes && i < seq_length; i++) {
+            writes[i] = (unsigned char)is_write_ref(i, write_pct);
         }
     }
 
-    /* 初始化WSClock环境 */
+    unsigned long long start_ns = wsclock_now_ns();
+    int rc = wsclock_sweep_run(points, count, sequence, writes, seq_length, timing, threads);
+    double elapsed_ms = (double)(wsclock_now_ns() - start_ns) / 1e6;
+
+    if (rc == 0) {
+        FILE* fp = output ? fopen(output, "w") : stdout;
+        if (!fp) {
+            printf("无法写入结果文件: %s\n", output);
+            rc = -1;
+        } else {
+            size_t len = output ? strlen(output) : 0;
+            if (len >= 5 && strcmp(output + len - 5, ".json") == 0) {
+                wsclock_sweep_write_json(fp, points, count);
+            } else {
+                wsclock_sweep_write_csv(fp, points, count);
+            }
+            if (fp != stdout) fclose(fp);
+        }
+        fprintf(stderr, "参数扫描完成：%d 个配置，%d 个线程，耗时 %.1f ms\n", count, threads, elapsed_ms);
+    } else {
+        /* 有配置点失败时不写结果文件，避免输出全零的行 */
+        int failed = 0;
+        for (int i = 0; i < count; i++) {
+            if (points[i].status == 0) continue;
+            if (failed < 5) {
+                printf("配置点 procs=%d pages=%d ws=%d tau=%d 模拟失败(内存不足)\n",
+                       points[i].process_count, points[i].page_count,
+                       points[i].working_set_size, points[i].scan_period);
+            }
+            failed++;
+        }
+        printf("参数扫描失败：%d/%d 个配置点未完成，未写出结果\n", failed, count);
+    }
+    free(writes);
+    free(points);
+    return rc == 0 ? 0 : 1;
+}
+
+/*
+ * 采样模拟的验证：对网格中每个配置点(未给出网格时只有 -n/-k/-s 对应的一个点)
+ * 先做完整模拟，再做采样模拟，比较缺页率估计与真实值
+ */
+static int run_shards(const char* spec, double rate, int replicas, int threads,
+                      const int* sequence, int seq_length,
+                      int page_count, int working_set_size, int scan_period)
+{
+    WSClockSweepPoint defaults;
+    memset(&defaults, 0, sizeof(defaults));
+    defaults.process_count = 3;
+    defaults.page_count = page_count;
+    defaults.working_set_size = working_set_size;
+    defaults.scan_period = scan_period;
+
+    WSClockSweepGrid* grid = (WSClockSweepGrid*)malloc(sizeof(WSClockSweepGrid));
+    if (!grid || wsclock_sweep_parse(spec ? spec : "", &defaults, grid) != 0) {
+        printf("无法解析扫描网格: %s\n", spec ? spec : "");
+        free(grid);
+        return 1;
+    }
+    WSClockSweepPoint* points = NULL;
+    int count = wsclock_sweep_expand(grid, &points);
+    free(grid);
+    if (count <= 0) {
+        printf("扫描网格为空或过大\n");
+        return 1;
+    }
+
+    /* 完整模拟作为基准 */
+    if (wsclock_sweep_run(points, count, sequence, NULL, seq_length, NULL, threads) != 0) {
+        printf("完整模拟失败\n");
+        free(points);
+        return 1;
+    }
+
+    printf("采样模拟验证：采样率 %g, %d 个副本, 序列长度 %d\n", rate, replicas, seq_length);
+    printf("%5s %6s %4s %4s | %9s %9s %9s %9s | %8s %8s %8s\n",
+           "procs", "pages", "ws", "tau", "full", "sampled", "ci95", "abs_err",
+           "ws'", "speedup", "mem_x");
+
+    double sum_err = 0.0, max_err = 0.0;
+    int covered = 0;
+    for (int i = 0; i < count; i++) {
+        const WSClockSweepPoint* pt = &points[i];
+        WSClockShardsConfig cfg;
+        cfg.rate = rate;
+        cfg.replicas = replicas;
+        cfg.process_count = pt->process_count;
+        cfg.page_count = pt->page_count;
+        cfg.working_set_size = pt->working_set_size;
+        cfg.scan_period = pt->scan_period;
+
+        WSClockShardsResult r;
+        if (wsclock_shards_run(sequence, seq_length, &cfg, &r) != 0) {
+            printf("采样模拟失败\n");
+            free(points);
+            return 1;
+        }
+        double err = r.fault_rate > pt->fault_rate ? r.fault_rate - pt->fault_rate
+                                                   : pt->fault_rate - r.fault_rate;
+        if (err <= r.fault_rate_ci95) covered++;
+        sum_err += err;
+        if (err > max_err) max_err = err;
+
+        /* 加速比与内存比都按单个副本计算 */
+        double per_replica_ns = (double)r.elapsed_ns / (double)replicas;
+        double speedup = per_replica_ns > 0 ? (double)pt->elapsed_ns / per_replica_ns : 0.0;
+        double full_pages = (double)pt->process_count * (double)pt->page_count;
+        double mem_x = r.sampled_pages > 0 ? full_pages / r.sampled_pages : 0.0;
+        printf("%5d %6d %4d %4d | %9.5f %9.5f %9.5f %9.5f | %8d %8.1f %8.1f\n",
+               pt->process_count, pt->page_count, pt->working_set_size, pt->scan_period,
+               pt->fault_rate, r.fault_rate, r.fault_rate_ci95, err,
+               r.scaled_ws, speedup, mem_x);
+    }
+    printf("平均绝对误差 %.5f, 最大绝对误差 %.5f, 误差落在95%%置信区间内的配置 %d/%d\n",
+           sum_err / count, max_err, covered, count);
+    free(points);
+    return 0;
+}
+
+/* 空闲页跟踪估计的一次回放结果 */
+typedef struct IdlePassStats {
+    unsigned long long sample_ns;
+    double abs_err;                    /* 各评估点 |估计 - 精确| 之和 */
+    double exact_sum;                  /* 各评估点精确 W 之和 */
+    double est_sum;
+    double max_rel;                    /* 单个评估点的最大相对误差 */
+    unsigned long long evals;          /* 评估点数(每条引用、每个进程一个) */
+    double proc_exact[IDLE_PROCESSES];
+    double proc_est[IDLE_PROCESSES];
+    double proc_abs[IDLE_PROCESSES];
+} IdlePassStats;
+
+/*
+ * 以 period 为采样周期回放一遍：估计器只在采样时读取访问位，
+ * 每条引用后(窗口填满以后)把各进程最近一次采样的估计值与精确的 W(t, tau) 比较
+ * keep 非NULL时把估计器交给调用方(用于输出空闲年龄直方图)
+ */
+static int idle_pass(const int* sequence, int seq_length, int page_count, unsigned long tau,
+                     unsigned long period, IdlePassStats* st, WSClockIdleTracker* keep)
+{
+    WSClockIdleTracker tracker;
+    WSClockIdleExact exact;
+    memset(st, 0, sizeof(IdlePassStats));
+    if (wsclock_idle_init(&tracker, IDLE_PROCESSES, page_count, period) != 0) return -1;
+    if (wsclock_idle_exact_init(&exact, IDLE_PROCESSES, page_count, tau) != 0) {
+        wsclock_idle_free(&tracker);
+        return -1;
+    }
+
+    double est[IDLE_PROCESSES];
+    memset(est, 0, sizeof(est));
+    for (int i = 0; i < seq_length; i++) {
+        int pid = i % IDLE_PROCESSES;
+        wsclock_idle_touch(&tracker, pid, sequence[i]);
+        wsclock_idle_exact_access(&exact, pid, sequence[i]);
+        unsigned long t = (unsigned long)i + 1;
+        if (t % period == 0) {
+            unsigned long long t0 = wsclock_now_ns();
+            wsclock_idle_sample(&tracker);
+            for (int p = 0; p < IDLE_PROCESSES; p++) {
+                est[p] = wsclock_idle_estimate(&tracker, p, tau);
+            }
+            st->sample_ns += wsclock_now_ns() - t0;
+        }
+        if (t < tau) continue;
+        for (int p = 0; p < IDLE_PROCESSES; p++) {
+            double e = (double)exact.count[p];
+            double d = est[p] > e ? est[p] - e : e - est[p];
+            st->abs_err += d;
+            st->exact_sum += e;
+            st->est_sum += est[p];
+            st->proc_exact[p] += e;
+            st->proc_est[p] += est[p];
+            st->proc_abs[p] += d;
+            if (e > 0 && d / e > st->max_rel) st->max_rel = d / e;
+            st->evals++;
+        }
+    }
+
+    wsclock_idle_exact_free(&exact);
+    if (keep) {
+        *keep = tracker;
+    } else {
+        wsclock_idle_free(&tracker);
+    }
+    return 0;
+}
+
+/*
+ * 空闲页跟踪估计：采样周期从 tau 开始逐次减半，找出平均相对误差不超过 max_err 的最大周期，
+ * 并输出该周期下各进程的估计误差与空闲年龄直方图
+ */
+static int run_idle(unsigned long tau, double max_err, const int* sequence, int seq_length, int page_count)
+{
+    if ((unsigned long)seq_length < tau) {
+        printf("序列长度 %d 小于 tau %lu，无法评估\n", seq_length, tau);
+        return 1;
+    }
+    printf("空闲页跟踪估计：tau %lu, 误差上限 %.1f%%, 序列长度 %d, %d 个进程, 每进程 %d 页\n",
+           tau, 100.0 * max_err, seq_length, IDLE_PROCESSES, page_count);
+    printf("%9s %8s %11s %10s %8s | %9s %9s %8s %8s\n",
+           "period", "samples", "scan_words", "ns/sample", "ns/ref", "exact_W", "est_W", "mean_err", "max_err");
+
+    unsigned long best = 0;
+    unsigned long smallest = tau;
+    for (unsigned long period = tau; period >= 1; period /= 2) {
+        /* tau 覆盖的采样次数不能超出直方图 */
+        if (tau / period >= WSCLOCK_IDLE_AGES - 1) break;
+        IdlePassStats st;
+        if (idle_pass(sequence, seq_length, page_count, tau, period, &st, NULL) != 0) {
+            printf("内存不足\n");
+            return 1;
+        }
+        unsigned long samples = (unsigned long)seq_length / period;
+        double mean_err = st.exact_sum > 0 ? st.abs_err / st.exact_sum : 0.0;
+        printf("%9lu %8lu %11llu %10.1f %8.2f | %9.2f %9.2f %7.2f%% %7.2f%%\n",
+               period, samples, (unsigned long long)samples * IDLE_PROCESSES * (unsigned long long)((page_count + 63) / 64),
+               samples ? (double)st.sample_ns / (double)samples : 0.0,
+               (double)st.sample_ns / (double)seq_length,
+               st.evals ? st.exact_sum / (double)st.evals : 0.0,
+               st.evals ? st.est_sum / (double)st.evals : 0.0,
+               100.0 * mean_err, 100.0 * st.max_rel);
+        if (!best && mean_err <= max_err) best = period;
+        smallest = period;
+        if (period == 1) break;
+    }
+
+    if (best) {
+        printf("误差不超过 %.1f%% 的最大采样周期: %lu (每 %lu 次引用采样一次)\n", 100.0 * max_err, best, best);
+    } else {
+        printf("所有采样周期的误差都超过 %.1f%%，以下按最小周期 %lu 输出\n", 100.0 * max_err, smallest);
+        best = smallest;
+    }
+
+    /* 选定周期下各进程的估计与空闲年龄直方图(按2的幂分组，单位为采样次数) */
+    IdlePassStats st;
+    WSClockIdleTracker tracker;
+    int* hist = (int*)malloc(sizeof(int) * WSCLOCK_IDLE_AGES);
+    if (!hist || idle_pass(sequence, seq_length, page_count, tau, best, &st, &tracker) != 0) {
+        printf("内存不足\n");
+        free(hist);
+        return 1;
+    }
+    printf("\n%7s %9s %9s %8s | idle age (samples):\n", "process", "exact_W", "est_W", "mean_err");
+    printf("%7s %9s %9s %8s |", "", "", "", "");
+    const char* labels[] = { "0", "1", "2-3", "4-7", "8-15", "16-31", "32-63", "64-127", "128+", "never" };
+    for (int b = 0; b < 10; b++) printf(" %7s", labels[b]);
+    printf("\n");
+    for (int p = 0; p < IDLE_PROCESSES; p++) {
+        double n = st.evals ? (double)st.evals / IDLE_PROCESSES : 1.0;
+        printf("%7d %9.2f %9.2f %7.2f%% |", p, st.proc_exact[p] / n, st.proc_est[p] / n,
+               st.proc_exact[p] > 0 ? 100.0 * st.proc_abs[p] / st.proc_exact[p] : 0.0);
+        int seen = wsclock_idle_histogram(&tracker, p, hist);
+        int bucket[10];
+        memset(bucket, 0, sizeof(bucket));
+        for (int a = 0; a < WSCLOCK_IDLE_AGES; a++) {
+            int b = 0;
+            while (b < 8 && a >= (1 << b)) b++;
+            bucket[b] += hist[a];
+        }
+        bucket[9] = page_count - seen;
+        for (int b = 0; b < 10; b++) printf(" %7d", bucket[b]);
+        printf("\n");
+    }
+    wsclock_idle_free(&tracker);
+    free(hist);
+    return 0;
+}
+
+/* fork/exit 频繁的负载的一次回放结果 */
+typedef struct ForkChurnStats {
+    unsigned long long refs;
+    unsigned long long faults;
+    unsigned long forks;
+    unsigned long exits;
+    int peak_processes;
+    long peak_entries;             /* 页表项峰值：实际分配的 / 不共享时需要的 */
+    long peak_mapped;
+    unsigned long long elapsed_ns;
+} ForkChurnStats;
+
+/*
+ * 主进程(下标0)每 period 次访问 fork 一个子进程，子进程存活 lifetime 次访问后退出；
+ * 访问序列在存活进程间轮转。eager 为1时 fork 改为创建新进程后逐项复制页表，作为对照
+ */
+static int fork_churn_pass(const int* sequence, int seq_length, int page_count, int working_set_size,
+                           int scan_period, int period, int lifetime, int eager,
+                           WSClockEnvironment* env, ForkChurnStats* out)
+{
+    memset(out, 0, sizeof(ForkChurnStats));
+    memset(env, 0, sizeof(WSClockEnvironment));
+    WSClockArena* arena = (WSClockArena*)malloc(sizeof(WSClockArena));
+    if (!arena) return -1;
+    wsclock_arena_init(arena, 0, WSCLOCK_ARENA_HUGEPAGE);
+    Process* master = (Process*)wsclock_arena_alloc(arena, sizeof(Process));
+    if (!master || wsclock_process_create(arena, master, 0, page_count, working_set_size) != 0) {
+        wsclock_arena_destroy(arena);
+        free(arena);
+        return -1;
+    }
+    wsclock_init(env, master, 1, NULL);
+    wsclock_arena_attach(env, arena);
+
+    /* 各下标上进程的创建时间(访问序号)，随进程数组一起增长 */
+    int birth_capacity = 16;
+    unsigned long long* birth = (unsigned long long*)calloc((size_t)birth_capacity, sizeof(unsigned long long));
+    int rc = birth ? 0 : -1;
+    int live = 1;
+    int cursor = 0;
+    int next_pid = 1;
+    unsigned long long start_ns = wsclock_now_ns();
+
+    for (int i = 0; rc == 0 && i < seq_length; i++) {
+        if (i > 0 && i % period == 0) {
+            int child;
+            if (eager) {
+                /* 对照：整表复制 */
+                Process* parent = &env->processes[0];
+                int ws = parent->working_set_size;
+                child = wsclock_process_spawn(env, next_pid, page_count, ws);
+                if (child >= 0) {
+                    parent = &env->processes[0];
+                    Process* c = &env->processes[child];
+                    for (int j = 0; j < page_count; j++) {
+                        *wsclock_page(c, j) = *wsclock_page(parent, j);
+                    }
+                    c->clock = parent->clock;
+                    c->counters.clock_base = c->clock;
+                    c->scan_cursor = parent->scan_cursor;
+                    c->ws_count = parent->ws_count;
+                }
+            } else {
+                child = wsclock_process_fork(env, 0, next_pid);
+            }
+            if (child < 0) {
+                rc = -1;
+                break;
+            }
+            if (child >= birth_capacity) {
+                int capacity = birth_capacity * 2;
+                while (capacity <= child) capacity *= 2;
+                unsigned long long* grown = (unsigned long long*)realloc(birth, sizeof(unsigned long long) * (size_t)capacity);
+                if (!grown) {
+                    rc = -1;
+                    break;
+                }
+                birth = grown;
+                birth_capacity = capacity;
+            }
+            birth[child] = (unsigned long long)i;
+            next_pid++;
+            out->forks++;
+            live++;
+            if (live > out->peak_processes) out->peak_processes = live;
+            long mapped, allocated;
+            wsclock_page_table_usage(env, &mapped, &allocated);
+            if (allocated > out->peak_entries) out->peak_entries = allocated;
+            if (mapped > out->peak_mapped) out->peak_mapped = mapped;
+        }
+
+        /* 轮转到下一个存活进程 */
+        do {
+            cursor = (cursor + 1) % env->process_count;
+        } while (!env->processes[cursor].active);
+
+        int result = wsclock_access_page(env, cursor, sequence[i]);
+        if (result != WSCLOCK_ACCESS_INVALID) {
+            out->refs++;
+            if (result & WSCLOCK_ACCESS_FAULT) out->faults++;
+        }
+
+        if ((i + 1) % scan_period == 0) {
+            for (int pi = 0; pi < env->process_count; pi++) {
+                wsclock_periodic_scan(env, pi);
+            }
+        }
+        for (int pi = 1; pi < env->process_count; pi++) {
+            if (env->processes[pi].active && (unsigned long long)i - birth[pi] >= (unsigned long long)lifetime) {
+                wsclock_process_exit(env, pi);
+                out->exits++;
+                live--;
+            }
+        }
+    }
+    out->elapsed_ns = wsclock_now_ns() - start_ns;
+    free(birth);
+    return rc;
+}
+
+/*
+ * fork/exit 频繁的负载：分别用写时复制和整表复制回放，比较页表复制量与耗时
+ */
+static int run_fork_churn(const char* spec, const int* sequence, int seq_length,
+                          int page_count, int working_set_size, int scan_period)
+{
+    int period = 0, lifetime = 0;
+    int fields = sscanf(spec, "%d,%d", &period, &lifetime);
+    if (fields < 1 || period <= 0) {
+        printf("无法解析 fork 参数: %s\n", spec);
+        return 1;
+    }
+    if (fields < 2 || lifetime <= 0) lifetime = period * 4;
+
+    printf("fork/exit 负载：每 %d 次访问 fork 一次，子进程存活 %d 次访问，每个进程 %d 页(叶子 %d 页)\n",
+           period, lifetime, page_count, WSCLOCK_LEAF_PAGES);
+
+    ForkChurnStats cow, eager;
     WSClockEnvironment env;
-    memset(&env, 0, sizeof(WSClockEnvironment));
-    wsclock_init(&env, allProcs, process_count, demo_log);
+    if (fork_churn_pass(sequence, seq_length, page_count, working_set_size, scan_period,
+                        period, lifetime, 0, &env, &cow) != 0) {
+        printf("写时复制回放失败：内存不足\n");
+        wsclock_cleanup(&env);
+        free(env.arena);
+        return 1;
+    }
+    unsigned long dir_copies = env.cow_dir_copies;
+    unsigned long leaf_copies = env.cow_leaf_copies;
+    WSClockArena* arena = env.arena;
+    wsclock_cleanup(&env);
+    free(arena);
+
+    if (fork_churn_pass(sequence, seq_length, page_count, working_set_size, scan_period,
+                        period, lifetime, 1, &env, &eager) != 0) {
+        printf("整表复制回放失败：内存不足\n");
+        arena = env.arena;
+        wsclock_cleanup(&env);
+        free(arena);
+        return 1;
+    }
+    arena = env.arena;
+    wsclock_cleanup(&env);
+    free(arena);
+
+    printf("  fork %lu 次, exit %lu 次, 同时存活的进程数峰值 %d\n", cow.forks, cow.exits, cow.peak_processes);
+    printf("  %-6s %12s %12s %14s %14s %10s\n", "mode", "refs", "faults", "entries_copied", "peak_entries", "ms");
+    printf("  %-6s %12llu %12llu %14llu %14ld %10.2f\n", "cow", cow.refs, cow.faults,
+           (unsigned long long)leaf_copies * WSCLOCK_LEAF_PAGES, cow.peak_entries, (double)cow.elapsed_ns / 1e6);
+    printf("  %-6s %12llu %12llu %14llu %14ld %10.2f\n", "eager", eager.refs, eager.faults,
+           (unsigned long long)eager.forks * (unsigned long long)page_count, eager.peak_entries,
+           (double)eager.elapsed_ns / 1e6);
+    printf("  写时复制：复制目录 %lu 次、叶子 %lu 次；缺页数%s\n", dir_copies, leaf_copies,
+           cow.faults == eager.faults ? "与整表复制一致" : "与整表复制不一致");
+    return cow.faults == eager.faults ? 0 : 1;
+}
+
+/*
+ * 打印插桩统计：每进程计数器与各接口的时延分布
+ */
+static void print_instrumentation(const WSClockEnvironment* env)
+{
+    static const char* op_names[WSCLOCK_OP_COUNT] = {
+        "access(hit)", "access(fault)", "find_victim", "periodic_scan", "scan_budget"
+    };
+    WSClockStatsSnapshot* snap = (WSClockStatsSnapshot*)malloc(sizeof(WSClockStatsSnapshot));
+    if (!snap || wsclock_stats_snapshot(snap) != 0) {
+        printf("\n插桩未编译(WSCLOCK_STATS=0)\n");
+        free(snap);
+        return;
+    }
+
+    printf("\n=== 插桩统计 ===\n");
+    for(int i=0; i<env->process_count; i++){
+        WSClockProcCounters c;
+        wsclock_stats_process(env, i, &c);
+        printf("  进程 %d: 命中 %llu, 缺页 %llu(次缺页 %llu), 置换 %llu, 写回 %llu, 每次置换扫描 %.1f 页, "
+               "周期扫描 %llu 次/%llu 页/清引用位 %llu\n",
+               i, c.hits, c.faults, c.minor_faults, c.evictions, c.writebacks,
+               c.victim_searches ? (double)c.victim_pages_scanned / (double)c.victim_searches : 0.0,
+               c.scans, c.scan_pages, c.bits_cleared);
+    }
+    printf("  各接口时延(ns)，%d 个线程，每 %d 次调用采样一次:\n",
+           snap->threads, 1 << WSCLOCK_STATS_SAMPLE_SHIFT);
+    printf("  %-14s %10s %9s %9s %9s %9s %9s\n", "op", "samples", "mean", "p50", "p90", "p99", "max");
+    for(int op=0; op<WSCLOCK_OP_COUNT; op++){
+        const WSClockHistogram* h = &snap->ops[op];
+        if (h->count == 0) continue;
+        printf("  %-14s %10llu %9.1f %9.1f %9.1f %9.1f %9.1f\n", op_names[op], h->count,
+               (double)h->sum / (double)h->count / snap->ticks_per_ns,
+               wsclock_hist_percentile(h, 0.50, snap->ticks_per_ns),
+               wsclock_hist_percentile(h, 0.90, snap->ticks_per_ns),
+               wsclock_hist_percentile(h, 0.99, snap->ticks_per_ns),
+               wsclock_hist_percentile(h, 1.0, snap->ticks_per_ns));
+    }
+    free(snap);
+}
+
+/*
+ * 导出时间序列：以.bin结尾为二进制，否则为CSV；事件另写到 <output>.events.csv
+ * (输出到标准输出时紧接在样本之后，中间空一行)
+ */
+static int write_series(const WSClockSeries* series, const char* output)
+{
+    size_t len = output ? strlen(output) : 0;
+    int binary = len >= 4 && strcmp(output + len - 4, ".bin") == 0;
+    FILE* fp = output ? fopen(output, binary ? "wb" : "w") : stdout;
+    if (!fp) {
+        printf("无法写入时间序列文件: %s\n", output);
+        return -1;
+    }
+
+    int rc = 0;
+    if (binary) {
+        rc = wsclock_series_write_binary(fp, series);
+    } else {
+        wsclock_series_write_csv(fp, series);
+        if (series->ev_page) {
+            FILE* efp = fp;
+            if (output) {
+                char* path = (char*)malloc(len + sizeof(".events.csv"));
+                if (path) {
+                    memcpy(path, output, len);
+                    strcpy(path + len, ".events.csv");
+                    efp = fopen(path, "w");
+                    free(path);
+                }
+            } else {
+                fputc('\n', fp);
+            }
+            if (efp) {
+                wsclock_series_write_events_csv(efp, series);
+                if (efp != fp) fclose(efp);
+            } else {
+                rc = -1;
+            }
+        }
+    }
+    if (fp != stdout) fclose(fp);
+    if (rc != 0) {
+        printf("时间序列写入失败\n");
+    }
+    return rc;
+}
+
+/*
+ * 多代老化策略代替 WSClock：与演示环境相同的3个进程、相同的轮转调度，
+ * 每 scan_period 次访问老化一代(对应 WSClock 的 periodic_scan)，输出格式与默认模式一致；
+ * series_interval > 0 时为安静模式，与默认模式一样记录时间序列并导出到 output
+ */
+static int run_mglru(const int* sequence, int seq_length, int page_count, int working_set_size,
+                     int scan_period, unsigned long series_interval, int series_delta, const char* output)
+{
+    int process_count = 3;
+    WSClockMglru procs[3];
+    memset(procs, 0, sizeof(procs));
+    for (int i = 0; i < process_count; i++) {
+        if (wsclock_mglru_init(&procs[i], page_count, working_set_size) != 0) {
+            printf("进程创建失败：内存不足\n");
+            for (int j = 0; j < i; j++) wsclock_mglru_free(&procs[j]);
+            return 1;
+        }
+    }
+
+    /* 时间序列只需要进程数与页数；没有页表的进程在初始化时视为空工作集 */
+    WSClockSeries series;
+    int series_enabled = 0;
+    int quiet = series_interval > 0;
+    if (quiet) {
+        Process shells[3];
+        WSClockEnvironment shell_env;
+        memset(shells, 0, sizeof(shells));
+        memset(&shell_env, 0, sizeof(shell_env));
+        for (int i = 0; i < process_count; i++) shells[i].page_count = page_count;
+        shell_env.processes = shells;
+        shell_env.process_count = process_count;
+        int flags = series_delta ? WSCLOCK_SERIES_EVENTS : WSCLOCK_SERIES_RESIDENT;
+        if (wsclock_series_init(&series, &shell_env, series_interval, (unsigned long long)seq_length, flags) == 0) {
+            series_enabled = 1;
+        } else {
+            printf("时间序列缓冲区分配失败，已关闭\n");
+        }
+    }
+
+    printf("开始调度(多代老化策略)，共有 %d 个进程，每个进程的工作集大小都为%d。\n",
+           process_count, working_set_size);
+    int current_proc = 0;
+    for (int i = 0; i < seq_length; i++) {
+        WSClockMglru* m = &procs[current_proc];
+        if (!quiet) {
+            printf("\n[调度] 让进程 %d 访问页面 %d\n", current_proc, sequence[i]);
+        }
+        int victim = -1;
+        int result = wsclock_mglru_access(m, sequence[i], &victim);
+        if (series_enabled) {
+            wsclock_series_record(&series, current_proc, sequence[i], result, victim);
+        } else if (!quiet && result != WSCLOCK_ACCESS_INVALID) {
+            printf("  %s工作集：", (result & WSCLOCK_ACCESS_FAULT) ? "缺页，" : "");
+            for (int j = 0; j < m->page_count; j++) {
+                if (wsclock_mglru_resident(m, j)) printf("%d ", j);
+            }
+            printf("\n");
+        }
+        current_proc = (current_proc + 1) % process_count;
+        if ((i + 1) % scan_period == 0) {
+            if (!quiet) {
+                printf("[调度] 老化一代...\n");
+            }
+            for (int pi = 0; pi < process_count; pi++) {
+                wsclock_mglru_age(&procs[pi]);
+            }
+        }
+    }
+
+    printf("\n=== 所有进程的最终工作集情况 ===\n");
+    for (int i = 0; i < process_count; i++) {
+        WSClockMglru* m = &procs[i];
+        printf("进程 %d:\n  工作集：", i);
+        for (int j = 0; j < m->page_count; j++) {
+            if (wsclock_mglru_resident(m, j)) printf("%d ", j);
+        }
+        printf("\n");
+    }
+
+    int rc = 0;
+    if (series_enabled) {
+        wsclock_series_finish(&series);
+        if (write_series(&series, output) == 0) {
+            fprintf(stderr, "时间序列：%d 个样本，%ld 个事件，丢弃 %lu 个样本/%lu 个事件\n",
+                    series.sample_count, series.event_count, series.dropped_samples, series.dropped_events);
+        } else {
+            rc = 1;
+        }
+        wsclock_series_free(&series);
+    }
+
+    printf("\n%-8s %10s %10s %10s %10s %10s %8s\n",
+           "process", "refs", "faults", "evictions", "scanned", "promoted", "gens");
+    for (int i = 0; i < process_count; i++) {
+        WSClockMglru* m = &procs[i];
+        printf("%-8d %10llu %10llu %10llu %10llu %10llu %8lu\n", i, m->refs, m->faults, m->evictions,
+               m->scanned, m->promoted, m->max_seq - m->min_seq + 1);
+        wsclock_mglru_free(m);
+    }
+    return rc;
+}
+
+/* 打印命令行用法 */
+static void print_usage(const char* prog)
+{
+    printf("用法: %s [引用序列文件] [选项]\n", prog);
+    printf("  -n N   每个进程的页数(默认6)\n");
+    printf("  -k K   每个进程的工作集容量(默认3)\n");
+    printf("  -s P   每P次访问清理一次引用位(默认%d)\n", SCAN_PERIOD);
+    printf("  -b K   增量扫描：每次访问后每个进程最多扫描K个页表项，K=0表示按周期P均匀摊开\n");
+    printf("  -B us  由后台线程每隔us微秒执行增量扫描，调度循环不再扫描\n");
+    printf("  -t N   并发模式：N个线程同时访问进程0(共享地址空间)，回放序列-r遍\n");
+    printf("  -r R   并发/事件调度模式下回放序列的遍数(默认1000)\n");
+    printf("  -w W   写访问比例(百分比，默认0)，脏页被置换时需要写回\n");
+    printf("  -T hit,fault,wb,qd  启用时延模型(纳秒)：命中延迟,缺页服务时间,写回时间,设备队列深度\n");
+    printf("         例如 -T 100,100000,150000,4\n");
+    printf("  -E Q   事件驱动调度：每个进程是一个协程，缺页时挂起等待设备，时间片Q次访问\n");
+    printf("  -m M   事件驱动调度的负载控制：最多同时装入M个进程(默认不限)\n");
+    printf("  -M F   事件驱动调度的负载控制：物理页框总数F，装入进程的工作集容量之和不超过F\n");
+    printf("  -S 网格 参数扫描，例如 -S \"ws=2:8 tau=1:10 procs=1:4 pages=20\"\n");
+    printf("         取值可写为 a、a,b,c、a:b 或 a:b:step；未给出的维度使用 -n/-k/-s 的值(进程数默认3)\n");
+    printf("  -o 文件 参数扫描结果输出文件(默认标准输出CSV；以.json结尾时输出JSON)\n");
+    printf("  -j N   参数扫描使用的线程数(默认4)\n");
+    printf("  -Z P[,W[,load,store]] 分层内存：被置换页降级到容量P页的压缩池；W 为工作集窗口，按本进程自己的访问次数计，\n");
+    printf("         被置换页距上次访问不超过W次时仍属于工作集、进入压缩池，否则直接换出到交换设备\n");
+    printf("         (默认 W 等于 -s 的扫描周期，W=0 表示全部进入压缩池；被置换页都已空闲一段时间，W 过小时全部直接换出)；\n");
+    printf("         load/store为解压/压缩一页的纳秒数(默认2000,4000)；\n");
+    printf("         命中与换入换出时间取自 -T，并与没有压缩池时的换入次数对比\n");
+    printf("  -H N   共享段：每个进程的前N页映射到同一个共享段(如共享库代码)，按引用计数驻留，\n");
+    printf("         结束时输出各进程的 RSS/PSS/USS\n");
+    printf("  -P     结束时输出插桩统计(每进程计数器、各接口时延分布)\n");
+    printf("  -q N   安静模式：不逐次打印工作集，每N次访问记录各进程的工作集大小、缺页率与驻留页，\n");
+    printf("         结束时一次性导出到 -o 指定的文件(以.bin结尾时为二进制，否则为CSV；默认标准输出)\n");
+    printf("  -d     与 -q 合用：不记录驻留页快照，改为记录换入/换出事件(CSV 时写到 <文件>.events.csv)\n");
+    printf("  -R r[,k] 空间采样近似模拟：只保留哈希值低于阈值的页面(采样率r)，工作集容量按r缩放，\n");
+    printf("         用k个独立哈希种子(默认5)给出误差范围，并与完整模拟对比；可与 -S 组合逐点验证\n");
+    printf("  -A wsclock|mglru 置换策略：mglru 按同样的轮转调度回放序列，每 -s 次访问老化一代代替清理引用位；\n");
+    printf("         mglru 只支持 -n/-k/-s 与 -q/-d/-o，不能与 -b/-B/-t/-w/-T/-E/-Z/-H/-P/-L 或 -S/-R/-I/-C/-F 组合\n");
+    printf("  -I tau[,e] 空闲页跟踪估计：估计器只能周期性读取并清零访问位，由空闲年龄直方图估计各进程的 W(t,tau)，\n");
+    printf("         与完整序列上精确的 W(t,tau) 比较；采样周期从 tau 起逐次减半，给出平均误差不超过 e%%(默认5)的最大周期\n");
+    printf("  -C 文件 把引用序列转换为压缩格式(差分+varint，分块并带索引)写入文件，并比较大小与读取时间；\n");
+    printf("         引用序列文件为压缩格式时自动识别，各块用 %d 个线程并行解码\n", TRACE_DECODE_THREADS);
+    printf("  -L first|freq[,N] 页号重排：剖析序列前N条引用(默认整个序列)，按第一次访问或访问次数重新编号，\n");
+    printf("         使热点页集中在页表开头；输出仍使用原页号(对 -S/-R/-F/-C 不生效)\n");
+    printf("  -F p[,l] fork/exit 负载：主进程每p次访问 fork 一个子进程，子进程存活l次访问(默认4p)后退出，\n");
+    printf("         分别用写时复制页表与整表复制回放，比较复制的页表项数与耗时\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const char* trace_file = "page_refs.txt";
+    int scan_budget = -1;          /* <0 表示使用原有的整表扫描 */
+    long bg_interval_us = -1;      /* >=0 表示使用后台扫描线程 */
+    int thread_count = 0;          /* >0 表示多线程并发访问模式 */
+    int replay_rounds = 1000;
+    int page_count = 6;
+    int working_set_size = 3;
+    int scan_period = SCAN_PERIOD;
+    int write_pct = 0;
+    int timing_enabled = 0;
+    WSClockTimingConfig timing_config = { 100, 100000, 150000, 4 };
+    int sched_quantum = 0;         /* >0 表示事件驱动调度模式 */
+    int sched_max_active = 0;
+    int sched_frames = 0;
+    const char* sweep_spec = NULL;
+    const char* sweep_output = NULL;
+    int sweep_threads = 4;
+    double shards_rate = 0.0;      /* >0 表示空间采样模拟 */
+    int shards_replicas = 5;
+    int tier_enabled = 0;
+    int tier_window_set = 0;       /* 0 表示工作集窗口取扫描周期 */
+    int shared_pages = 0;          /* >0 表示前 shared_pages 页为共享页 */
+    int print_stats = 0;
+    unsigned long series_interval = 0;  /* >0 表示安静模式下的采样间隔 */
+    int series_delta = 0;
+    const char* fork_spec = NULL;  /* 非NULL表示 fork/exit 负载模式 */
+    const char* compress_output = NULL;
+    int renumber_mode = -1;        /* >=0 表示按 WSCLOCK_RENUMBER_* 重排页号 */
+    int renumber_prefix = 0;
+    int use_mglru = 0;             /* 1 表示用多代老化策略代替 WSClock */
+    unsigned long idle_tau = 0;    /* >0 表示空闲页跟踪估计模式 */
+    double idle_err_pct = 5.0;
+    WSClockTierConfig tier_config = { 0, 0, 2000, 4000, 0, 0, 0 };
+
+    for (int ai = 1; ai < argc; ai++) {
+        if (strcmp(argv[ai], "-b") == 0 && ai + 1 < argc) {
+            scan_budget = atoi(argv[++ai]);
+            if (scan_budget < 0) scan_budget = 0;
+        } else if (strcmp(argv[ai], "-B") == 0 && ai + 1 < argc) {
+            bg_interval_us = atol(argv[++ai]);
+            if (bg_interval_us < 0) bg_interval_us = 0;
+        } else if (strcmp(argv[ai], "-t") == 0 && ai + 1 < argc) {
+            thread_count = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-r") == 0 && ai + 1 < argc) {
+            replay_rounds = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-n") == 0 && ai + 1 < argc) {
+            page_count = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-k") == 0 && ai + 1 < argc) {
+            working_set_size = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-s") == 0 && ai + 1 < argc) {
+            scan_period = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-w") == 0 && ai + 1 < argc) {
+            write_pct = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-T") == 0 && ai + 1 < argc) {
+            if (sscanf(argv[++ai], "%lu,%lu,%lu,%d", &timing_config.hit_ns, &timing_config.fault_ns,
+                       &timing_config.writeback_ns, &timing_config.queue_depth) != 4) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            timing_enabled = 1;
+        } else if (strcmp(argv[ai], "-E") == 0 && ai + 1 < argc) {
+            sched_quantum = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-m") == 0 && ai + 1 < argc) {
+            sched_max_active = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-M") == 0 && ai + 1 < argc) {
+            sched_frames = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-S") == 0 && ai + 1 < argc) {
+            sweep_spec = argv[++ai];
+        } else if (strcmp(argv[ai], "-o") == 0 && ai + 1 < argc) {
+            sweep_output = argv[++ai];
+        } else if (strcmp(argv[ai], "-j") == 0 && ai + 1 < argc) {
+            sweep_threads = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-Z") == 0 && ai + 1 < argc) {
+            int fields = sscanf(argv[++ai], "%d,%lu,%lu,%lu", &tier_config.zpool_pages, &tier_config.ws_window,
+                                &tier_config.zpool_load_ns, &tier_config.zpool_store_ns);
+            if (fields < 1 || tier_config.zpool_pages < 0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            tier_window_set = fields >= 2;
+            tier_enabled = 1;
+        } else if (strcmp(argv[ai], "-H") == 0 && ai + 1 < argc) {
+            shared_pages = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-P") == 0) {
+            print_stats = 1;
+        } else if (strcmp(argv[ai], "-q") == 0 && ai + 1 < argc) {
+            series_interval = strtoul(argv[++ai], NULL, 10);
+            if (series_interval == 0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[ai], "-d") == 0) {
+            series_delta = 1;
+        } else if (strcmp(argv[ai], "-L") == 0 && ai + 1 < argc) {
+            const char* spec = argv[++ai];
+            if (strncmp(spec, "first", 5) == 0) {
+                renumber_mode = WSCLOCK_RENUMBER_FIRST_TOUCH;
+            } else if (strncmp(spec, "freq", 4) == 0) {
+                renumber_mode = WSCLOCK_RENUMBER_FREQUENCY;
+            } else {
+                print_usage(argv[0]);
+                return 1;
+            }
+            const char* comma = strchr(spec, ',');
+            renumber_prefix = comma ? atoi(comma + 1) : 0;
+        } else if (strcmp(argv[ai], "-A") == 0 && ai + 1 < argc) {
+            const char* policy = argv[++ai];
+            if (strcmp(policy, "mglru") == 0) {
+                use_mglru = 1;
+            } else if (strcmp(policy, "wsclock") == 0) {
+                use_mglru = 0;
+            } else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[ai], "-I") == 0 && ai + 1 < argc) {
+            if (sscanf(argv[++ai], "%lu,%lf", &idle_tau, &idle_err_pct) < 1 ||
+                idle_tau == 0 || idle_err_pct < 0.0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[ai], "-C") == 0 && ai + 1 < argc) {
+            compress_output = argv[++ai];
+        } else if (strcmp(argv[ai], "-F") == 0 && ai + 1 < argc) {
+            fork_spec = argv[++ai];
+        } else if (strcmp(argv[ai], "-R") == 0 && ai + 1 < argc) {
+            if (sscanf(argv[++ai], "%lf,%d", &shards_rate, &shards_replicas) < 1 ||
+                shards_rate <= 0.0 || shards_rate > 1.0 || shards_replicas <= 0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (argv[ai][0] == '-') {
+            print_usage(argv[0]);
+            return 1;
+        } else {
+            trace_file = argv[ai];
+        }
+    }
+    if (page_count <= 0 || working_set_size <= 0 || scan_period <= 0 ||
+        shared_pages < 0 || shared_pages > page_count) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    /* 多代老化策略没有 WSClock 的页表、扫描器与调度器，这些选项没有对应的实现 */
+    if (use_mglru &&
+        (scan_budget >= 0 || bg_interval_us >= 0 || thread_count > 0 || write_pct > 0 || timing_enabled ||
+         sched_quantum > 0 || tier_enabled || shared_pages > 0 || print_stats || renumber_mode >= 0 ||
+         sweep_spec || shards_rate > 0.0 || idle_tau > 0 || compress_output || fork_spec)) {
+        print_usage(argv[0]);
+        return 1;
+    }
 
     /* 读取某个访问序列(可自定义多个文件对应多个进程) 
        或者统一使用一份序列，在调度循环中交替让不同进程访问 */
     int seq_length = 0;
-    int* sequence = load_page_sequence("page_refs.txt", &seq_length);
+    int* sequence = load_page_sequence(trace_file, &seq_length);
     if(seq_length <= 0){
         printf("page_refs.txt 读取失败或无内容，使用内置模拟\n");
         seq_length = 6;
@@ -89,33 +1087,299 @@ int main()
         memcpy(sequence, dummy, sizeof(dummy));
     }
 
-    printf("开始调度，共有 %d 个进程，每个进程的工作集大小都为3。\n", process_count);
+    /* 采样模拟模式：与完整模拟逐点对比 */
+    if (shards_rate > 0.0) {
+        int rc = run_shards(sweep_spec, shards_rate, shards_replicas, sweep_threads, sequence, seq_length,
+                            page_count, working_set_size, scan_period);
+        free(sequence);
+        return rc;
+    }
 
-    /* 简单的轮转调度示例 */
-    int current_proc = 0;
-    for(int i=0; i<seq_length; i++){
-        int page_id = sequence[i];
-        printf("\n[调度] 让进程 %d 访问页面 %d\n", current_proc, page_id);
-        wsclock_access_page(&env, current_proc, page_id);
-
-        /* 显示工作集当前状况 */
-        Process* p = &allProcs[current_proc];
-        printf("  工作集：");
-        for(int j=0; j<p->page_count; j++){
-            if(p->page_table[j].in_working_set){
-                printf("%d ", p->page_table[j].page_id);
+    /* 空闲页跟踪估计模式：只用采样到的访问位估计工作集，与精确值对比 */
+    if (idle_tau > 0) {
+        int rc = run_idle(idle_tau, idle_err_pct / 100.0, sequence, seq_length, page_count);
+        free(sequence);
+        return rc;
+    }
+
+    /* 转换为压缩格式：序列按演示环境的3个进程轮转划分 */
+    if (compress_output) {
+        int rc = run_compress(trace_file, compress_output, sequence, seq_length, 3, sweep_threads);
+        free(sequence);
+        return rc;
+    }
+
+    /* fork/exit 负载模式：进程动态创建与退出，不使用演示环境 */
+    if (fork_spec) {
+        int rc = run_fork_churn(fork_spec, sequence, seq_length, page_count, working_set_size, scan_period);
+        free(sequence);
+        return rc;
+    }
+
+    /* 参数扫描模式：不创建演示环境，直接在线程池上运行所有配置 */
+    if (sweep_spec) {
+        int rc = run_sweep(sweep_spec, sweep_output, sweep_threads, sequence, seq_length,
+                           page_count, working_set_size, scan_period, write_pct, &timing_config);
+        free(sequence);
+        return rc;
+    }
+
+    /* 多代老化策略：不使用 WSClock 的演示环境 */
+    if (use_mglru) {
+        int rc = run_mglru(sequence, seq_length, page_count, working_set_size, scan_period,
+                           series_interval, series_delta, sweep_output);
+        free(sequence);
+        return rc;
+    }
+
+    /* 页号重排：序列换成新页号，输出时经 remap 换回原页号(remap 为NULL时不变) */
+    WSClockRenumber renumber;
+    WSClockRenumber* remap = NULL;
+    if (renumber_mode >= 0) {
+        unsigned long long t0 = wsclock_now_ns();
+        if (wsclock_renumber_build(&renumber, sequence, seq_length, renumber_prefix, page_count, renumber_mode) == 0) {
+            wsclock_renumber_apply(&renumber, sequence, seq_length);
+            remap = &renumber;
+            printf("页号重排(%s)：剖析 %d 条引用，出现 %d 个页号，耗时 %.2f ms\n",
+                   renumber_mode == WSCLOCK_RENUMBER_FREQUENCY ? "按访问次数" : "按第一次访问",
+                   renumber.profiled_refs, renumber.touched, (double)(wsclock_now_ns() - t0) / 1e6);
+        } else {
+            printf("页号重排失败：内存不足，使用原页号\n");
+        }
+    }
+
+    /* 假设系统中有3个进程；进程控制块与页表都从分配器的大页对齐 slab 中切分 */
+    int process_count = 3;
+    WSClockArena arena;
+    wsclock_arena_init(&arena, 0, WSCLOCK_ARENA_HUGEPAGE);
+    Process* allProcs = (Process*)wsclock_arena_alloc(&arena, sizeof(Process)*process_count);
+
+    /* 初始化各进程的页表与工作集大小(示例数值：每个进程的页数默认6，工作集容量默认3) */
+    for(int i=0; allProcs && i<process_count; i++){
+        if (wsclock_process_create(&arena, &allProcs[i], i, page_count, working_set_size) != 0) {
+            allProcs = NULL;
+        }
+    }
+    if (!allProcs) {
+        printf("进程创建失败：内存不足\n");
+        wsclock_arena_destroy(&arena);
+        wsclock_renumber_free(remap);
+        free(sequence);
+        return 1;
+    }
+
+    /* 初始化WSClock环境 */
+    WSClockEnvironment env;
+    memset(&env, 0, sizeof(WSClockEnvironment));
+    /* 并发/事件调度/安静模式下不打印每次缺页，避免控制台输出成为瓶颈 */
+    wsclock_init(&env, allProcs, process_count,
+                 (thread_count > 0 || sched_quantum > 0 || series_interval > 0) ? NULL : demo_log);
+    wsclock_arena_attach(&env, &arena);
+
+    /* 共享段：所有进程的前 shared_pages 页映射到段0 */
+    WSClockSharedTable shared_table;
+    wsclock_shared_init(&shared_table);
+    if (shared_pages > 0) {
+        int ok = wsclock_shared_add_segment(&shared_table, 0, shared_pages) == 0;
+        for(int i=0; ok && i<process_count; i++){
+            if (remap) {
+                /* 原页号连续的前 shared_pages 页重排后不再连续，逐页映射 */
+                for(int j=0; ok && j<shared_pages; j++){
+                    ok = wsclock_shared_map(&allProcs[i], &shared_table, wsclock_renumber_mapped(remap, j), 0, j, 1) == 0;
+                }
+            } else {
+                ok = wsclock_shared_map(&allProcs[i], &shared_table, 0, 0, 0, shared_pages) == 0;
             }
         }
-        printf("\n");
+        if (ok) {
+            wsclock_shared_attach(&env, &shared_table);
+        } else {
+            printf("共享段创建失败，所有页按私有页处理\n");
+        }
+    }
 
-        /* 每次访问后轮换到下一个进程 */
-        current_proc = (current_proc + 1) % process_count;
+    printf("开始调度，共有 %d 个进程，每个进程的工作集大小都为%d。\n", process_count, working_set_size);
+
+    /*
+     * 时延模型：由每次访问的结果驱动，只有轮转调度路径逐条记录。
+     * 事件驱动调度用 -T 的参数自行计算等待I/O与设备利用率，并发模式不计时延，二者都不输出时延模型统计
+     */
+    WSClockTimingModel timing;
+    if (thread_count > 0 || sched_quantum > 0) {
+        timing_enabled = 0;
+    }
+    if (timing_enabled && wsclock_timing_init(&timing, &timing_config, process_count) != 0) {
+        printf("时延模型初始化失败，已关闭\n");
+        timing_enabled = 0;
+    }
+
+    /* 分层内存模型：同时运行一个没有压缩池的对照模型，比较换入次数 */
+    WSClockTierModel tier;
+    WSClockTierModel tier_baseline;
+    if (tier_enabled) {
+        /* 未给出窗口时按 WSClock 自己的工作集估计：一个扫描周期内被访问过的页属于工作集 */
+        if (!tier_window_set) {
+            tier_config.ws_window = (unsigned long)scan_period;
+        }
+        tier_config.dram_ns = timing_config.hit_ns;
+        tier_config.swap_in_ns = timing_config.fault_ns;
+        tier_config.swap_out_ns = timing_config.writeback_ns;
+        WSClockTierConfig baseline_config = tier_config;
+        baseline_config.zpool_pages = 0;
+        if (wsclock_tier_init(&tier, &tier_config, &env) != 0) {
+            printf("分层内存模型初始化失败，已关闭\n");
+            tier_enabled = 0;
+        } else if (wsclock_tier_init(&tier_baseline, &baseline_config, &env) != 0) {
+            printf("分层内存模型初始化失败，已关闭\n");
+            wsclock_tier_free(&tier);
+            tier_enabled = 0;
+        }
+    }
+
+    /* 安静模式的时间序列：缓冲区按访问总数一次分配 */
+    WSClockSeries series;
+    int series_enabled = 0;
+    if (series_interval > 0 && thread_count == 0 && sched_quantum == 0) {
+        int flags = series_delta ? WSCLOCK_SERIES_EVENTS : WSCLOCK_SERIES_RESIDENT;
+        if (wsclock_series_init(&series, &env, series_interval, (unsigned long long)seq_length, flags) == 0) {
+            series_enabled = 1;
+        } else {
+            printf("时间序列缓冲区分配失败，已关闭\n");
+        }
+    }
+
+    /* 后台扫描线程：均匀地在时间轴上清理引用位 */
+    WSClockScanner scanner;
+    memset(&scanner, 0, sizeof(WSClockScanner));
+    if (bg_interval_us >= 0) {
+        if (wsclock_scanner_start(&scanner, &env, scan_budget, (unsigned int)bg_interval_us) != 0) {
+            printf("后台扫描线程启动失败，改用调度循环内扫描\n");
+            bg_interval_us = -1;
+        }
+    }
+
+    /* 增量扫描的统计 */
+    unsigned long scan_calls = 0;
+    unsigned long long scan_pages = 0;
+    unsigned long long scan_total_ns = 0;
+    unsigned long long scan_max_ns = 0;
+
+    if (thread_count > 0) {
+        /* 多线程并发访问同一进程：命中路径无锁，置换按进程串行化 */
+        WSClockThreadRunStats tstats;
+        printf("并发模式：%d 个线程同时访问进程 0，每个线程回放 %d 遍\n", thread_count, replay_rounds);
+        if (wsclock_run_threaded(&env, 0, sequence, seq_length, thread_count, replay_rounds, &tstats) == 0) {
+            printf("  访问总数: %llu, 耗时: %.3f ms, 吞吐量: %.0f 次/秒\n",
+                   tstats.references, (double)tstats.elapsed_ns / 1e6, tstats.refs_per_sec);
+        } else {
+            printf("  线程创建失败\n");
+        }
+    } else if (sched_quantum > 0) {
+        /* 事件驱动调度：序列按轮转方式拆成每个进程自己的引用流 */
+        int** streams = (int**)calloc((size_t)process_count, sizeof(int*));
+        int* lengths = (int*)calloc((size_t)process_count, sizeof(int));
+        for(int pi=0; streams && lengths && pi<process_count; pi++){
+            streams[pi] = (int*)malloc(sizeof(int) * (size_t)(seq_length / process_count + 1));
+            for(int i=pi; streams[pi] && i<seq_length; i+=process_count){
+                streams[pi][lengths[pi]++] = sequence[i];
+            }
+        }
+
+        WSClockSchedConfig sched_config;
+        sched_config.timing = timing_config;
+        sched_config.quantum = sched_quantum;
+        sched_config.max_active = sched_max_active;
+        sched_config.memory_frames = sched_frames;
 
-        /* 每若干次(如5次访问)之后可以触发一次周期性扫描，模拟对引用位清零 */
-        if ((i+1) % 5 == 0) {
-            printf("[调度] 执行 periodic_scan...\n");
+        WSClockSchedStats sstats;
+        WSClockSchedProcessStats* pstats =
+            (WSClockSchedProcessStats*)calloc((size_t)process_count, sizeof(WSClockSchedProcessStats));
+        printf("事件驱动调度：时间片 %d 次访问, 进程上限 %d, 页框 %d, 每个进程回放 %d 遍\n",
+               sched_quantum, sched_max_active, sched_frames, replay_rounds);
+        if (streams && lengths && pstats &&
+            wsclock_sched_run(&env, (const int* const*)streams, lengths, replay_rounds,
+                              &sched_config, &sstats, pstats) == 0) {
+            printf("  访问: %llu, 缺页: %llu, 总耗时: %.3f ms, 同时装入进程数最多 %d\n",
+                   sstats.refs, sstats.faults, (double)sstats.makespan_ns / 1e6, sstats.max_concurrent);
+            printf("  吞吐量: %.0f 次访问/秒, CPU利用率: %.1f%%, 设备利用率: %.1f%%\n",
+                   sstats.throughput, 100.0 * sstats.cpu_utilization, 100.0 * sstats.device_utilization);
             for(int pi=0; pi<process_count; pi++){
-                wsclock_periodic_scan(&env, pi);
+                printf("  进程 %d: 缺页 %llu, 等待I/O %.3f ms, 等待CPU %.3f ms, 装入 %.3f ms, 完成 %.3f ms\n",
+                       pi, pstats[pi].faults, (double)pstats[pi].stall_ns / 1e6,
+                       (double)pstats[pi].ready_ns / 1e6, (double)pstats[pi].admit_ns / 1e6,
+                       (double)pstats[pi].finish_ns / 1e6);
+            }
+        } else {
+            printf("  事件驱动调度失败\n");
+        }
+        for(int pi=0; streams && pi<process_count; pi++){
+            free(streams[pi]);
+        }
+        free(streams);
+        free(lengths);
+        free(pstats);
+    } else {
+        /* 简单的轮转调度示例 */
+        int current_proc = 0;
+        for(int i=0; i<seq_length; i++){
+            int page_id = sequence[i];
+            if (!series_interval) {
+                printf("\n[调度] 让进程 %d 访问页面 %d\n", current_proc, wsclock_renumber_original(remap, page_id));
+            }
+            int victim = -1;
+            int result = wsclock_access_page_ex(&env, current_proc, page_id,
+                                                is_write_ref(i, write_pct), &victim);
+            if (timing_enabled) {
+                wsclock_timing_record(&timing, current_proc, result);
+            }
+            if (tier_enabled) {
+                wsclock_tier_record(&tier, current_proc, page_id, result, victim);
+                wsclock_tier_record(&tier_baseline, current_proc, page_id, result, victim);
+            }
+
+            if (series_enabled) {
+                wsclock_series_record(&series, current_proc, wsclock_renumber_original(remap, page_id), result,
+                                      wsclock_renumber_original(remap, victim));
+            } else if (!series_interval) {
+                /* 显示工作集当前状况 */
+                Process* p = &allProcs[current_proc];
+                printf("  工作集：");
+                for(int j=0; j<p->page_count; j++){
+                    Page* page = wsclock_page(p, wsclock_renumber_mapped(remap, j));
+                    if(page->in_working_set){
+                        printf("%d ", wsclock_renumber_original(remap, page->page_id));
+                    }
+                }
+                printf("\n");
+            }
+
+            /* 每次访问后轮换到下一个进程 */
+            current_proc = (current_proc + 1) % process_count;
+
+            if (bg_interval_us >= 0) {
+                /* 由后台线程负责扫描 */
+            } else if (scan_budget >= 0) {
+                /* 增量扫描：每次访问后每个进程扫描一小段，scan_period次访问完成一整轮 */
+                for(int pi=0; pi<process_count; pi++){
+                    int budget = scan_budget > 0
+                        ? scan_budget
+                        : wsclock_scan_budget_for_period(allProcs[pi].page_count, scan_period);
+                    WSClockScanStats stats;
+                    if (wsclock_periodic_scan_budget(&env, pi, budget, &stats) >= 0) {
+                        scan_calls++;
+                        scan_pages += (unsigned long long)stats.pages_scanned;
+                        scan_total_ns += stats.elapsed_ns;
+                        if (stats.elapsed_ns > scan_max_ns) scan_max_ns = stats.elapsed_ns;
+                    }
+                }
+            } else if ((i+1) % scan_period == 0) {
+                /* 每若干次(如5次访问)之后可以触发一次周期性扫描，模拟对引用位清零 */
+                if (!series_interval) {
+                    printf("[调度] 执行 periodic_scan...\n");
+                }
+                for(int pi=0; pi<process_count; pi++){
+                    wsclock_periodic_scan(&env, pi);
+                }
             }
         }
     }
@@ -126,22 +1390,111 @@ int main()
         Process* p = &allProcs[i];
         printf("进程 %d:\n  工作集：", i);
         for(int j=0; j<p->page_count; j++){
-            if(p->page_table[j].in_working_set){
-                printf("%d ", p->page_table[j].page_id);
+            Page* page = wsclock_page(p, wsclock_renumber_mapped(remap, j));
+            if(page->in_working_set){
+                printf("%d ", wsclock_renumber_original(remap, page->page_id));
             }
         }
         printf("\n");
     }
 
-    /* 释放资源 */
-    wsclock_cleanup(&env);
+    /* 时间序列导出 */
+    if (series_enabled) {
+        wsclock_series_finish(&series);
+        if (write_series(&series, sweep_output) == 0) {
+            fprintf(stderr, "时间序列：%d 个样本，%ld 个事件，丢弃 %lu 个样本/%lu 个事件\n",
+                    series.sample_count, series.event_count, series.dropped_samples, series.dropped_events);
+        }
+        wsclock_series_free(&series);
+    }
 
-    for(int i=0; i<process_count; i++){
-        if(allProcs[i].page_table){
-            free(allProcs[i].page_table);
+    /* 共享页内存统计 */
+    if (env.shared) {
+        int rss_total = 0;
+        printf("\n=== 内存统计 (共享段 %d 页) ===\n", shared_pages);
+        for(int i=0; i<process_count; i++){
+            WSClockMemUsage usage;
+            wsclock_shared_usage(&env, i, &usage);
+            rss_total += usage.rss;
+            printf("  进程 %d: RSS %d 页(其中共享 %d), PSS %.2f 页, USS %d 页\n",
+                   i, usage.rss, usage.shared, usage.pss, usage.uss);
         }
+        printf("  RSS 之和: %d 页, 实际占用页框: %d 页\n", rss_total, wsclock_shared_resident_frames(&env));
+    }
+
+    /* 时延统计 */
+    if (timing_enabled) {
+        WSClockTimingReport report;
+        wsclock_timing_report(&timing, &report);
+        printf("\n=== 时延模型 (命中 %lu ns, 缺页 %lu ns, 写回 %lu ns, 队列深度 %d) ===\n",
+               timing_config.hit_ns, timing_config.fault_ns, timing_config.writeback_ns,
+               timing.config.queue_depth);
+        printf("  访问: %llu, 缺页: %llu, 写回: %llu\n", report.refs, report.faults, report.writebacks);
+        printf("  有效访问时间: %.1f ns, 设备利用率: %.1f%%, 总耗时: %.3f ms\n",
+               report.effective_access_ns, 100.0 * report.device_utilization,
+               (double)report.makespan_ns / 1e6);
+        for(int i=0; i<process_count; i++){
+            const WSClockTimingProcess* tp = &timing.procs[i];
+            printf("  进程 %d: 缺页 %llu, 写回 %llu, 阻塞 %.3f ms (%.1f%%)\n", i,
+                   tp->faults, tp->writebacks, (double)tp->stall_ns / 1e6,
+                   tp->now_ns ? 100.0 * (double)tp->stall_ns / (double)tp->now_ns : 0.0);
+        }
+        wsclock_timing_free(&timing);
+    }
+
+    /* 分层内存统计 */
+    if (tier_enabled) {
+        WSClockTierStats ts, bs;
+        wsclock_tier_report(&tier, &ts);
+        wsclock_tier_report(&tier_baseline, &bs);
+        printf("\n=== 分层内存 (压缩池 %d 页, 工作集窗口 %lu, 解压 %lu ns, 压缩 %lu ns) ===\n",
+               tier_config.zpool_pages, tier_config.ws_window,
+               tier_config.zpool_load_ns, tier_config.zpool_store_ns);
+        printf("  访问: %llu, DRAM命中: %llu, 首次访问: %llu\n", ts.refs, ts.dram_hits, ts.cold_faults);
+        printf("  压缩池提升: %llu, 交换换入: %llu, 降级到压缩池: %llu, 直接换出: %llu\n",
+               ts.zpool_promotions, ts.swap_ins, ts.zpool_demotions, ts.swap_demotions);
+        printf("  压缩池挤出: %llu, 交换写出: %llu, 压缩池峰值占用: %d 页\n",
+               ts.zpool_evictions, ts.swap_outs, ts.zpool_peak);
+        printf("  有效访问时间: %.1f ns\n", ts.effective_access_ns);
+        printf("  无压缩池对照: 交换换入 %llu, 交换写出 %llu, 有效访问时间 %.1f ns\n",
+               bs.swap_ins, bs.swap_outs, bs.effective_access_ns);
+        if (bs.swap_ins > 0) {
+            printf("  压缩池使交换换入减少 %.1f%%\n",
+                   100.0 * (double)(bs.swap_ins - ts.swap_ins) / (double)bs.swap_ins);
+        }
+        wsclock_tier_free(&tier);
+        wsclock_tier_free(&tier_baseline);
+    }
+
+    /* 扫描统计 */
+    if (bg_interval_us >= 0) {
+        wsclock_scanner_stop(&scanner);
+        scan_calls = scanner.calls;
+        scan_pages = scanner.pages_scanned;
+        scan_total_ns = scanner.total_ns;
+        scan_max_ns = scanner.max_ns;
     }
-    free(allProcs);
+    if (scan_calls > 0) {
+        printf("\n=== 增量扫描统计 ===\n");
+        printf("  调用次数: %lu, 扫描页表项: %llu, 平均耗时: %.1f ns, 最大耗时: %llu ns\n",
+               scan_calls, scan_pages, (double)scan_total_ns / (double)scan_calls, scan_max_ns);
+        for(int i=0; i<process_count; i++){
+            printf("  进程 %d: 已完成 %lu 轮, 当前游标 %d/%d\n", i,
+                   allProcs[i].scan_passes, allProcs[i].scan_cursor, allProcs[i].page_count);
+        }
+    }
+
+    if (print_stats) {
+        print_instrumentation(&env);
+    }
+
+    /* 释放资源：进程与页表随分配器在 wsclock_cleanup 中一起释放 */
+    for(int i=0; i<process_count; i++){
+        wsclock_shared_unmap(&allProcs[i]);
+    }
+    wsclock_shared_free(&shared_table);
+    wsclock_cleanup(&env);
+    wsclock_renumber_free(remap);
     free(sequence);
 
     return 0;
@@ -0,0 +1,167 @@
+#include <stdlib.h>
+#include <string.h>
+#include "wsclock_arena.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+/*
+ * 每段映射开头的头部：slab 链表节点
+ *  - large: 单独映射的大块，reset 时直接归还系统
+ */
+typedef struct WSClockArenaSlab {
+    struct WSClockArenaSlab* next;
+    size_t size;
+    int large;
+} WSClockArenaSlab;
+
+/* 头部占用的字节数，保证切分出的块 64 字节对齐 */
+#define SLAB_HEADER ((sizeof(WSClockArenaSlab) + 63) & ~(size_t)63)
+
+/* 申请 size 字节(WSCLOCK_ARENA_SLAB_SIZE 的倍数)并按 WSCLOCK_ARENA_SLAB_SIZE 对齐 */
+static void* map_aligned(size_t size, int flags)
+{
+#ifdef _WIN32
+    (void)flags;
+    /* VirtualAlloc 只保证 64KB 对齐；大页需要特权，这里不申请 */
+    return VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    size_t align = WSCLOCK_ARENA_SLAB_SIZE;
+    char* raw = (char*)mmap(NULL, size + align, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == (char*)MAP_FAILED) return NULL;
+
+    /* 多申请一个对齐单位，再把首尾多余的部分还回去 */
+    char* base = (char*)(((size_t)raw + align - 1) & ~(align - 1));
+    if (base > raw) munmap(raw, (size_t)(base - raw));
+    if (base + size < raw + size + align) munmap(base + size, (size_t)(raw + size + align - (base + size)));
+#ifdef MADV_HUGEPAGE
+    if (flags & WSCLOCK_ARENA_HUGEPAGE) madvise(base, size, MADV_HUGEPAGE);
+#else
+    (void)flags;
+#endif
+    return base;
+#endif
+}
+
+static void unmap_aligned(void* base, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, size);
+#endif
+}
+
+static WSClockArenaSlab* arena_map(WSClockArena* arena, size_t size, int large)
+{
+    WSClockArenaSlab* slab = (WSClockArenaSlab*)map_aligned(size, arena->flags);
+    if (!slab) return NULL;
+    slab->size = size;
+    slab->large = large;
+    slab->next = arena->slabs;
+    arena->slabs = slab;
+    arena->reserved += size;
+    arena->slab_count++;
+    return slab;
+}
+
+/* 大小对应的级别：2^(class + MIN_SHIFT) >= size */
+static int size_class(size_t size)
+{
+    int c = 0;
+    while (((size_t)1 << (c + WSCLOCK_ARENA_MIN_SHIFT)) < size) c++;
+    return c;
+}
+
+void wsclock_arena_init(WSClockArena* arena, size_t slab_size, int flags)
+{
+    if (!arena) return;
+    memset(arena, 0, sizeof(WSClockArena));
+    if (slab_size == 0) slab_size = WSCLOCK_ARENA_SLAB_SIZE;
+    arena->slab_size = (slab_size + WSCLOCK_ARENA_SLAB_SIZE - 1) & ~(WSCLOCK_ARENA_SLAB_SIZE - 1);
+    arena->flags = flags;
+}
+
+void* wsclock_arena_alloc(WSClockArena* arena, size_t size)
+{
+    if (!arena || size == 0) return NULL;
+    int c = size_class(size);
+    if (c >= WSCLOCK_ARENA_CLASSES) return NULL;
+    size_t block = (size_t)1 << (c + WSCLOCK_ARENA_MIN_SHIFT);
+
+    void* p = arena->free_lists[c];
+    if (p) {
+        /* 复用：空闲块的第一个字存放链表指针 */
+        arena->free_lists[c] = *(void**)p;
+        arena->reused++;
+    } else if (block > (arena->slab_size - SLAB_HEADER) / 4) {
+        /* 大块单独映射 */
+        size_t size_needed = SLAB_HEADER + block;
+        size_t map_size = (size_needed + WSCLOCK_ARENA_SLAB_SIZE - 1) & ~(WSCLOCK_ARENA_SLAB_SIZE - 1);
+        WSClockArenaSlab* slab = arena_map(arena, map_size, 1);
+        if (!slab) return NULL;
+        p = (char*)slab + SLAB_HEADER;
+    } else {
+        /* 按 min(块大小, 64) 对齐后切分 */
+        size_t align = block < 64 ? block : 64;
+        char* at = arena->cursor ? (char*)(((size_t)arena->cursor + align - 1) & ~(align - 1)) : NULL;
+        if (!at || at + block > arena->limit) {
+            WSClockArenaSlab* slab = arena_map(arena, arena->slab_size, 0);
+            if (!slab) return NULL;
+            arena->cursor = (char*)slab + SLAB_HEADER;
+            arena->limit = (char*)slab + arena->slab_size;
+            at = arena->cursor;
+        }
+        p = at;
+        arena->cursor = at + block;
+    }
+
+    memset(p, 0, size);
+    arena->allocs++;
+    arena->in_use += block;
+    return p;
+}
+
+void wsclock_arena_free(WSClockArena* arena, void* ptr, size_t size)
+{
+    if (!arena || !ptr || size == 0) return;
+    int c = size_class(size);
+    *(void**)ptr = arena->free_lists[c];
+    arena->free_lists[c] = ptr;
+    arena->in_use -= (size_t)1 << (c + WSCLOCK_ARENA_MIN_SHIFT);
+}
+
+void wsclock_arena_destroy(WSClockArena* arena)
+{
+    if (!arena) return;
+    WSClockArenaSlab* slab = arena->slabs;
+    while (slab) {
+        WSClockArenaSlab* next = slab->next;
+        unmap_aligned(slab, slab->size);
+        slab = next;
+    }
+    int flags = arena->flags;
+    size_t slab_size = arena->slab_size;
+    wsclock_arena_init(arena, slab_size, flags);
+}
+
+void wsclock_arena_attach(WSClockEnvironment* env, WSClockArena* arena)
+{
+    if (env) env->arena = arena;
+}
+
+int wsclock_process_create(WSClockArena* arena, Process* proc, int process_id, int page_count, int working_set_size)
+{
+    if (!arena || !proc || page_count <= 0) return -1;
+
+    memset(proc, 0, sizeof(Process));
+    if (wsclock_page_table_init(proc, arena, page_count) != 0) return -1;
+    proc->process_id = process_id;
+    proc->working_set_size = working_set_size;
+    proc->active = 1;
+    return 0;
+}
@@ -0,0 +1,91 @@
+#ifndef WSCLOCK_ARENA_H
+#define WSCLOCK_ARENA_H
+
+#include <stddef.h>
+#include "wsclock_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* slab 大小与对齐：2MB，与 x86-64 的大页相同，便于内核用大页映射 */
+#define WSCLOCK_ARENA_SLAB_SIZE  ((size_t)2 << 20)
+
+/* 分配粒度：块大小向上取到 2 的幂，最小 16 字节 */
+#define WSCLOCK_ARENA_MIN_SHIFT  4
+#define WSCLOCK_ARENA_CLASSES    40
+
+/*
+ * 标志
+ *  - WSCLOCK_ARENA_HUGEPAGE: 新 slab 调用 madvise(MADV_HUGEPAGE)，请求透明大页
+ */
+#define WSCLOCK_ARENA_HUGEPAGE   0x1
+
+struct WSClockArenaSlab;
+
+/*
+ * 区域分配器：一次向系统申请对齐的大 slab，在其中顺序切分
+ *  - 块按 2 的幂分级，释放的块挂在所属级别的空闲链表上，分配与释放都是 O(1)，
+ *    同样大小的页表反复创建/销毁时直接复用，不产生碎片
+ *  - 超过 slab 四分之一的块单独占用一段对齐的映射，释放后同样进入空闲链表复用
+ *  - 不是线程安全的：每个 WSClockEnvironment(或每个线程)使用自己的分配器
+ */
+typedef struct WSClockArena {
+    size_t slab_size;
+    int flags;
+    struct WSClockArenaSlab* slabs;    /* 所有映射(含单独映射的大块)，销毁时统一释放 */
+    char* cursor;                      /* 当前 slab 中未切分部分 [cursor, limit) */
+    char* limit;
+    void* free_lists[WSCLOCK_ARENA_CLASSES];
+
+    /* 统计 */
+    size_t reserved;                   /* 向系统申请的字节数 */
+    size_t in_use;                     /* 已分配出去的字节数(按级别大小计) */
+    unsigned long slab_count;
+    unsigned long allocs;
+    unsigned long reused;              /* 从空闲链表取得的分配次数 */
+} WSClockArena;
+
+/*
+ * 初始化
+ * 参数:
+ *   - slab_size: 0 表示 WSCLOCK_ARENA_SLAB_SIZE；会向上取整到 WSCLOCK_ARENA_SLAB_SIZE 的倍数
+ *   - flags: WSCLOCK_ARENA_* 组合
+ */
+void wsclock_arena_init(WSClockArena* arena, size_t slab_size, int flags);
+
+/*
+ * 分配 size 字节，内容清零，至少按 16 字节对齐
+ * 返回值: 内存不足时为 NULL
+ */
+void* wsclock_arena_alloc(WSClockArena* arena, size_t size);
+
+/*
+ * 归还由 wsclock_arena_alloc 分配的块，size 必须与分配时相同
+ */
+void wsclock_arena_free(WSClockArena* arena, void* ptr, size_t size);
+
+/*
+ * 释放全部 slab
+ */
+void wsclock_arena_destroy(WSClockArena* arena);
+
+/*
+ * 把分配器交给环境管理：wsclock_cleanup 时销毁，此后由它分配的进程与页表都不再可用
+ */
+void wsclock_arena_attach(WSClockEnvironment* env, WSClockArena* arena);
+
+/*
+ * 从分配器创建进程：页表取自 arena，字段按 main.c 的默认方式初始化(激活、页面全不在工作集中)；
+ * 进程退出时由 wsclock_process_exit(wsclock_lifecycle.h)调整共享页引用计数并把页表还给 env->arena
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或内存不足
+ */
+int wsclock_process_create(WSClockArena* arena, Process* proc, int process_id, int page_count, int working_set_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_ARENA_H */
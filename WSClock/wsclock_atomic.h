@@ -0,0 +1,77 @@
+#ifndef WSCLOCK_ATOMIC_H
+#define WSCLOCK_ATOMIC_H
+
+/*
+ * 页表字段的原子访问宏：
+ *  - 引用位(referenced)、时间戳(age)、工作集标记(in_working_set)、进程时钟等
+ *    可能被多个访问线程和后台扫描线程并发读写
+ *  - GCC/Clang 下使用 __atomic 内建函数(relaxed 语义即可，只需保证单个字段读写不撕裂)
+ *  - 其他编译器退化为普通读写，仅适用于单线程场景
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <sched.h>
+
+#define WS_ATOMIC_LOAD(p)         __atomic_load_n((p), __ATOMIC_RELAXED)
+#define WS_ATOMIC_STORE(p, v)     __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define WS_ATOMIC_XCHG(p, v)      __atomic_exchange_n((p), (v), __ATOMIC_RELAXED)
+#define WS_ATOMIC_FETCH_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+/* 发布/获取指针：先填好内容再用 release 存指针，读者用 acquire 读到指针后一定能看到内容 */
+#define WS_ATOMIC_LOAD_ACQUIRE(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define WS_ATOMIC_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+#if defined(__x86_64__) || defined(__i386__)
+#define WS_CPU_RELAX()            __builtin_ia32_pause()
+#else
+#define WS_CPU_RELAX()            ((void)0)
+#endif
+
+/*
+ * 时间戳只允许向前推进：并发命中时较晚的时钟值不会被较早的覆盖
+ */
+static inline void ws_atomic_max_ulong(unsigned long* p, unsigned long v)
+{
+    unsigned long cur = __atomic_load_n(p, __ATOMIC_RELAXED);
+    while (cur < v &&
+           !__atomic_compare_exchange_n(p, &cur, v, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        /* cur 已被更新为最新值，重试 */
+    }
+}
+
+/*
+ * 轻量自旋锁：只用于串行化同一进程的缺页/置换路径，命中路径不加锁
+ */
+static inline void ws_spin_lock(int* lock)
+{
+    int spins = 0;
+    while (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n(lock, __ATOMIC_RELAXED)) {
+            if (++spins < 64) {
+                WS_CPU_RELAX();
+            } else {
+                spins = 0;
+                sched_yield(); /* 持锁方在扫描页表，让出CPU */
+            }
+        }
+    }
+}
+
+static inline void ws_spin_unlock(int* lock)
+{
+    __atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+}
+#else
+#define WS_ATOMIC_LOAD(p)         (*(p))
+#define WS_ATOMIC_STORE(p, v)     ((void)(*(p) = (v)))
+static inline int ws_atomic_xchg_int(int* p, int v) { int old = *p; *p = v; return old; }
+#define WS_ATOMIC_XCHG(p, v)      ws_atomic_xchg_int((p), (v))
+#define WS_ATOMIC_FETCH_ADD(p, v) ((*(p) += (v)) - (v))
+#define WS_ATOMIC_LOAD_ACQUIRE(p)     (*(p))
+#define WS_ATOMIC_STORE_RELEASE(p, v) ((void)(*(p) = (v)))
+#define WS_CPU_RELAX()            ((void)0)
+static inline void ws_atomic_max_ulong(unsigned long* p, unsigned long v) { if (*p < v) *p = v; }
+static inline void ws_spin_lock(int* lock) { *lock = 1; }
+static inline void ws_spin_unlock(int* lock) { *lock = 0; }
+#endif
+
+#endif /* WSCLOCK_ATOMIC_H */
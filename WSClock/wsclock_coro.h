@@ -0,0 +1,24 @@
+#ifndef WSCLOCK_CORO_H
+#define WSCLOCK_CORO_H
+
+/*
+ * 无栈协程宏(基于 switch/__LINE__ 的 protothread 写法)
+ *  - 协程函数每次被调用时从上次挂起的位置继续执行
+ *  - 挂起点之间需要保留的变量必须放在调用方提供的结构体中，不能用局部变量
+ *  - 同一行只能写一个挂起点，协程体内不能再使用 switch 语句包住挂起点
+ */
+
+typedef int WSCoroutine;   /* 保存恢复点(源代码行号)，0 表示从头开始 */
+
+/* 协程函数的返回状态 */
+#define WS_CO_READY  0     /* 主动让出CPU，仍可继续运行 */
+#define WS_CO_WAIT   1     /* 等待外部事件(如缺页I/O完成)，事件到达前不可调度 */
+#define WS_CO_DONE   2     /* 协程已执行完毕 */
+
+#define WS_CO_INIT(co)          ((co) = 0)
+#define WS_CO_BEGIN(co)         switch (co) { case 0:
+#define WS_CO_YIELD(co, status) do { (co) = __LINE__; return (status); case __LINE__:; } while (0)
+#define WS_CO_AWAIT(co)         WS_CO_YIELD(co, WS_CO_WAIT)
+#define WS_CO_END(co)           } (co) = -1; return WS_CO_DONE
+
+#endif /* WSCLOCK_CORO_H */
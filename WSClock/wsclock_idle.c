@@ -0,0 +1,166 @@
+#include <stdlib.h>
+#include <string.h>
+#include "wsclock_idle.h"
+
+int wsclock_idle_init(WSClockIdleTracker* tracker, int process_count, int page_count, unsigned long period)
+{
+    if (!tracker || process_count <= 0 || page_count <= 0 || period == 0) return -1;
+
+    memset(tracker, 0, sizeof(WSClockIdleTracker));
+    tracker->process_count = process_count;
+    tracker->page_count = page_count;
+    tracker->words = (page_count + 63) / 64;
+    tracker->period = period;
+
+    size_t procs = (size_t)process_count;
+    tracker->accessed = (unsigned long long*)calloc(procs * (size_t)tracker->words, sizeof(unsigned long long));
+    tracker->last_seen = (unsigned int*)calloc(procs * (size_t)page_count, sizeof(unsigned int));
+    tracker->seen_count = (int*)calloc(procs * WSCLOCK_IDLE_AGES, sizeof(int));
+    tracker->old_count = (int*)calloc(procs, sizeof(int));
+    if (!tracker->accessed || !tracker->last_seen || !tracker->seen_count || !tracker->old_count) {
+        wsclock_idle_free(tracker);
+        return -1;
+    }
+    return 0;
+}
+
+void wsclock_idle_sample(WSClockIdleTracker* tracker)
+{
+    if (!tracker) return;
+    unsigned int s = ++tracker->samples;
+    int slot = (int)(s % WSCLOCK_IDLE_AGES);
+
+    for (int p = 0; p < tracker->process_count; p++) {
+        unsigned long long* bits = &tracker->accessed[(size_t)p * (size_t)tracker->words];
+        unsigned int* last = &tracker->last_seen[(size_t)p * (size_t)tracker->page_count];
+        int* seen = &tracker->seen_count[(size_t)p * WSCLOCK_IDLE_AGES];
+
+        /* 这一格原来记的是第 s - AGES 次采样看到的页，它们的年龄到了 AGES，移入 old_count */
+        tracker->old_count[p] += seen[slot];
+        seen[slot] = 0;
+
+        for (int w = 0; w < tracker->words; w++) {
+            unsigned long long word = bits[w];
+            if (!word) continue;
+            bits[w] = 0;
+            for (; word; word &= word - 1) {
+                int page = w * 64 + __builtin_ctzll(word);
+                unsigned int prev = last[page];
+                if (prev) {
+                    if (s - prev < WSCLOCK_IDLE_AGES) {
+                        seen[prev % WSCLOCK_IDLE_AGES]--;
+                    } else {
+                        tracker->old_count[p]--;
+                    }
+                }
+                last[page] = s;
+                seen[slot]++;
+                tracker->seen_pages++;
+            }
+        }
+        tracker->scanned_words += (unsigned long long)tracker->words;
+    }
+}
+
+int wsclock_idle_histogram(const WSClockIdleTracker* tracker, int process_index, int* hist)
+{
+    if (!tracker || !hist || process_index < 0 || process_index >= tracker->process_count) return -1;
+
+    const int* seen = &tracker->seen_count[(size_t)process_index * WSCLOCK_IDLE_AGES];
+    unsigned int s = tracker->samples;
+    int total = tracker->old_count[process_index];
+    hist[WSCLOCK_IDLE_AGES - 1] = tracker->old_count[process_index];
+    for (int a = 0; a < WSCLOCK_IDLE_AGES; a++) {
+        int n = (unsigned int)a < s ? seen[(s - (unsigned int)a) % WSCLOCK_IDLE_AGES] : 0;
+        if (a < WSCLOCK_IDLE_AGES - 1) {
+            hist[a] = n;
+        } else {
+            hist[a] += n;
+        }
+        total += n;
+    }
+    return total;
+}
+
+double wsclock_idle_estimate(const WSClockIdleTracker* tracker, int process_index, unsigned long tau)
+{
+    if (!tracker || process_index < 0 || process_index >= tracker->process_count) return 0.0;
+
+    const int* seen = &tracker->seen_count[(size_t)process_index * WSCLOCK_IDLE_AGES];
+    unsigned int s = tracker->samples;
+    double m = (double)tau / (double)tracker->period;
+    if (m > (double)(WSCLOCK_IDLE_AGES - 1)) m = (double)(WSCLOCK_IDLE_AGES - 1);
+    int whole = (int)m;
+
+    /* 年龄 a < whole 的整格，加上跨窗口起点的第 whole 格 */
+    double w = 0.0;
+    for (int a = 0; a <= whole && (unsigned int)a < s; a++) {
+        int n = seen[(s - (unsigned int)a) % WSCLOCK_IDLE_AGES];
+        w += a < whole ? (double)n : (m - (double)whole) * (double)n;
+    }
+    return w;
+}
+
+void wsclock_idle_free(WSClockIdleTracker* tracker)
+{
+    if (!tracker) return;
+    free(tracker->accessed);
+    free(tracker->last_seen);
+    free(tracker->seen_count);
+    free(tracker->old_count);
+    memset(tracker, 0, sizeof(WSClockIdleTracker));
+}
+
+int wsclock_idle_exact_init(WSClockIdleExact* exact, int process_count, int page_count, unsigned long tau)
+{
+    if (!exact || process_count <= 0 || page_count <= 0 || tau == 0) return -1;
+
+    memset(exact, 0, sizeof(WSClockIdleExact));
+    exact->process_count = process_count;
+    exact->page_count = page_count;
+    exact->tau = tau;
+    exact->last_ref = (unsigned long long*)calloc((size_t)process_count * (size_t)page_count,
+                                                  sizeof(unsigned long long));
+    exact->ring = (int*)malloc(sizeof(int) * (size_t)tau);
+    exact->count = (int*)calloc((size_t)process_count, sizeof(int));
+    if (!exact->last_ref || !exact->ring || !exact->count) {
+        wsclock_idle_exact_free(exact);
+        return -1;
+    }
+    return 0;
+}
+
+void wsclock_idle_exact_access(WSClockIdleExact* exact, int process_index, int page)
+{
+    if (!exact) return;
+    unsigned long long t = ++exact->vtime;
+    size_t slot = (size_t)(t % exact->tau);
+
+    /* 时刻 t - tau 的引用滑出窗口(它与本次引用占用同一个环形缓冲区位置) */
+    if (t > exact->tau) {
+        int old = exact->ring[slot];
+        if (old >= 0 && exact->last_ref[old] == t - exact->tau) {
+            exact->count[old / exact->page_count]--;
+        }
+    }
+
+    int key = -1;
+    if (process_index >= 0 && process_index < exact->process_count && page >= 0 && page < exact->page_count) {
+        key = process_index * exact->page_count + page;
+        /* 上次引用已不在窗口内(或从未引用)时进入窗口 */
+        if (exact->last_ref[key] == 0 || exact->last_ref[key] + exact->tau <= t) {
+            exact->count[process_index]++;
+        }
+        exact->last_ref[key] = t;
+    }
+    exact->ring[slot] = key;
+}
+
+void wsclock_idle_exact_free(WSClockIdleExact* exact)
+{
+    if (!exact) return;
+    free(exact->last_ref);
+    free(exact->ring);
+    free(exact->count);
+    memset(exact, 0, sizeof(WSClockIdleExact));
+}
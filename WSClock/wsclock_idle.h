@@ -0,0 +1,105 @@
+#ifndef WSCLOCK_IDLE_H
+#define WSCLOCK_IDLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 空闲年龄直方图的格数(按采样次数计)，更老的页并入最后一格 */
+#define WSCLOCK_IDLE_AGES 256
+
+/*
+ * 空闲页跟踪(仿 Linux idle page tracking)：估计器看不到每次引用，只能周期性地读取并清零访问位
+ *  - 每个进程一张访问位图，引用时由"MMU"置位(wsclock_idle_touch)，相当于 wsclock_periodic_scan 清理的引用位
+ *  - 每 period 次引用采样一次(wsclock_idle_sample)：逐字扫描位图，只处理置位的页，并清零整张位图
+ *  - 每页记住最后一次被采样看到的采样序号，空闲年龄 = 当前采样序号 - 该序号
+ *  - 各进程按"最后看到的采样序号"计数，放在 WSCLOCK_IDLE_AGES 格的环形数组里，
+ *    采样时年龄整体加一只需把最老一格并入 old_count，不必逐页更新
+ */
+typedef struct WSClockIdleTracker {
+    int process_count;
+    int page_count;
+    int words;                     /* 每进程位图的64位字数 */
+    unsigned long period;          /* 采样周期(引用数) */
+    unsigned int samples;          /* 已完成的采样次数 */
+
+    unsigned long long* accessed;  /* 各进程的访问位图 */
+    unsigned int* last_seen;       /* 每页最后被看到的采样序号，0 表示从未看到 */
+    int* seen_count;               /* 每进程 WSCLOCK_IDLE_AGES 格，第 s % AGES 格为最后在第 s 次采样看到的页数 */
+    int* old_count;                /* 每进程空闲年龄 >= WSCLOCK_IDLE_AGES 的页数 */
+
+    /* 采样开销 */
+    unsigned long long scanned_words;
+    unsigned long long seen_pages; /* 各次采样中访问位为1的页数之和 */
+} WSClockIdleTracker;
+
+/*
+ * 初始化
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或内存不足
+ */
+int wsclock_idle_init(WSClockIdleTracker* tracker, int process_count, int page_count, unsigned long period);
+
+/*
+ * 引用：置访问位(越界的进程号/页号忽略)
+ */
+static inline void wsclock_idle_touch(WSClockIdleTracker* tracker, int process_index, int page)
+{
+    if (process_index < 0 || process_index >= tracker->process_count ||
+        page < 0 || page >= tracker->page_count) {
+        return;
+    }
+    tracker->accessed[(unsigned long)process_index * (unsigned long)tracker->words + (unsigned long)(page / 64)]
+        |= 1ULL << (page % 64);
+}
+
+/*
+ * 采样：读取并清零所有进程的访问位，更新空闲年龄
+ */
+void wsclock_idle_sample(WSClockIdleTracker* tracker);
+
+/*
+ * 进程的空闲年龄直方图：hist[a] 为空闲年龄为 a 次采样的页数，
+ * hist[WSCLOCK_IDLE_AGES - 1] 含更老的页；从未被看到的页不计入
+ * 返回值: 被看到过的页数；进程号非法时为 -1
+ */
+int wsclock_idle_histogram(const WSClockIdleTracker* tracker, int process_index, int* hist);
+
+/*
+ * 由直方图估计最近一次采样时刻 t 的工作集大小 W(t, tau)：
+ * 空闲年龄为 a 的页最后一次访问落在 (t-(a+1)*period, t-a*period] 内，
+ * 完全落在窗口 (t-tau, t] 内的整格计入，跨窗口起点的一格按窗口覆盖的比例计入
+ * (tau 须小于 (WSCLOCK_IDLE_AGES - 1) * period，更大时按该值截断)
+ */
+double wsclock_idle_estimate(const WSClockIdleTracker* tracker, int process_index, unsigned long tau);
+
+void wsclock_idle_free(WSClockIdleTracker* tracker);
+
+/*
+ * 精确的 W(t, tau)：完整引用序列上的滑动窗口，count[p] 为进程 p 在最近 tau 次引用中访问过的不同页数
+ *  - 每次引用 O(1)：页进入窗口时计数加一；滑出窗口的那次引用若是该页最后一次引用，计数减一
+ *  - 保存最近 tau 次引用的环形缓冲区
+ */
+typedef struct WSClockIdleExact {
+    int process_count;
+    int page_count;
+    unsigned long tau;
+    unsigned long long vtime;
+    unsigned long long* last_ref;  /* 每页最后一次引用的时刻(从1开始)，0 表示从未引用 */
+    int* ring;                     /* 最近 tau 次引用的 进程号 * page_count + 页号，越界引用为 -1 */
+    int* count;
+} WSClockIdleExact;
+
+int wsclock_idle_exact_init(WSClockIdleExact* exact, int process_count, int page_count, unsigned long tau);
+
+/* 记录一次引用(越界的引用只推进时间) */
+void wsclock_idle_exact_access(WSClockIdleExact* exact, int process_index, int page);
+
+void wsclock_idle_exact_free(WSClockIdleExact* exact);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_IDLE_H */
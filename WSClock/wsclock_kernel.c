@@ -1,8 +1,17 @@
 #include "wsclock_kernel.h"
+#include "wsclock_atomic.h"
+#include "wsclock_time.h"
+#include "wsclock_shared.h"
+#include "wsclock_stats.h"
+#include "wsclock_arena.h"
+#include <stdlib.h>
+#include <string.h>
 
 /* 内部函数声明 */
 static void log_msg(WSClockEnvironment* env, const char* msg);
-static Page* find_victim_page(Process* proc);
+static int find_victim_page(Process* proc);
+static Page* page_for_write(WSClockEnvironment* env, Process* proc, int process_index, int page_index);
+static WSClockSharedPage* shared_page_of(WSClockEnvironment* env, Process* proc, int page_index);
 
 void wsclock_init(WSClockEnvironment* env, 
                   Process* processes,
@@ -14,101 +23,399 @@ void wsclock_init(WSClockEnvironment* env,
     env->processes = processes;
     env->process_count = process_count;
     env->logger = logger;
+    env->shared = 0;
+    env->arena = 0;
+
+    /* 统计各进程已在工作集中的页数，复位置换锁，清零计数器 */
+    for (int p = 0; p < process_count; p++) {
+        Process* proc = &processes[p];
+        proc->ws_count = 0;
+        proc->evict_lock = 0;
+        memset(&proc->counters, 0, sizeof(WSClockProcCounters));
+        proc->counters.clock_base = proc->clock;
+        for (int i = 0; proc->page_dir && i < proc->page_count; i++) {
+            if (wsclock_page(proc, i)->in_working_set) {
+                proc->ws_count++;
+            }
+        }
+    }
+    env->process_capacity = process_count;
+    env->processes_owned = 0;
+    env->cow_lock = 0;
+    env->cow_dir_copies = 0;
+    env->cow_leaf_copies = 0;
+}
+
+/*
+ * 页表内存：有分配器时从分配器切分，否则用 calloc/free
+ */
+static void* table_alloc(struct WSClockArena* arena, size_t size)
+{
+    return arena ? wsclock_arena_alloc(arena, size) : calloc(1, size);
+}
+
+static void table_free(struct WSClockArena* arena, void* p, size_t size)
+{
+    if (arena) {
+        wsclock_arena_free(arena, p, size);
+    } else {
+        free(p);
+    }
+}
+
+static size_t dir_bytes(int leaf_count)
+{
+    return sizeof(WSClockPageDir) + sizeof(WSClockLeaf*) * (size_t)(leaf_count - 1);
+}
+
+static void leaf_free(struct WSClockArena* arena, WSClockLeaf* leaf)
+{
+    table_free(arena, leaf->pages, sizeof(Page) * WSCLOCK_LEAF_PAGES);
+    table_free(arena, leaf, sizeof(WSClockLeaf));
+}
+
+static WSClockLeaf* leaf_alloc(struct WSClockArena* arena)
+{
+    WSClockLeaf* leaf = (WSClockLeaf*)table_alloc(arena, sizeof(WSClockLeaf));
+    if (!leaf) return 0;
+    leaf->pages = (Page*)table_alloc(arena, sizeof(Page) * WSCLOCK_LEAF_PAGES);
+    if (!leaf->pages) {
+        table_free(arena, leaf, sizeof(WSClockLeaf));
+        return 0;
+    }
+    leaf->refcount = 1;
+    leaf->owner = -1;
+    return leaf;
+}
+
+int wsclock_page_table_init(Process* proc, struct WSClockArena* arena, int page_count)
+{
+    if (!proc || page_count <= 0) return -1;
+
+    int leaf_count = (page_count + WSCLOCK_LEAF_PAGES - 1) >> WSCLOCK_LEAF_SHIFT;
+    WSClockPageDir* dir = (WSClockPageDir*)table_alloc(arena, dir_bytes(leaf_count));
+    if (!dir) return -1;
+    dir->refcount = 1;
+    dir->owner = -1;
+    dir->leaf_count = 0;
+    proc->page_dir = dir;
+    proc->page_count = page_count;
+    proc->cow_pending = leaf_count + 1;
+    for (int k = 0; k < leaf_count; k++) {
+        WSClockLeaf* leaf = leaf_alloc(arena);
+        if (!leaf) {
+            wsclock_page_table_release(proc, arena);
+            return -1;
+        }
+        memset(leaf->pages, 0, sizeof(Page) * WSCLOCK_LEAF_PAGES);
+        for (int j = 0; j < WSCLOCK_LEAF_PAGES; j++) {
+            leaf->pages[j].page_id = (k << WSCLOCK_LEAF_SHIFT) + j;
+        }
+        dir->leaves[dir->leaf_count++] = leaf;
+    }
+    return 0;
+}
+
+void wsclock_page_table_release(Process* proc, struct WSClockArena* arena)
+{
+    if (!proc || !proc->page_dir) return;
+    WSClockPageDir* dir = proc->page_dir;
+    proc->page_dir = 0;
+    if (WS_ATOMIC_FETCH_ADD(&dir->refcount, -1) > 1) return;
+
+    for (int k = 0; k < dir->leaf_count; k++) {
+        WSClockLeaf* leaf = dir->leaves[k];
+        if (WS_ATOMIC_FETCH_ADD(&leaf->refcount, -1) == 1) {
+            leaf_free(arena, leaf);
+        }
+    }
+    table_free(arena, dir, dir_bytes(dir->leaf_count));
+}
+
+/*
+ * 写时复制(调用方持有 env->cow_lock)：
+ *  - 目录/叶子只被一个引用者引用时直接认领(owner 设为本进程)
+ *  - 否则复制一份归本进程所有，原件引用计数减1。复制目录时叶子的引用计数加1，
+ *    并撤销叶子原来的 owner，之后两个进程写叶子时都要再走一次写时复制
+ * 原件的引用计数只会减到1，不会在这里释放，其他线程手里的旧指针仍然有效
+ */
+static WSClockPageDir* dir_for_write_locked(WSClockEnvironment* env, Process* proc, int process_index)
+{
+    WSClockPageDir* dir = proc->page_dir;
+    if (dir->owner == process_index) return dir;
+    if (dir->refcount == 1) {
+        /* 认领目录后重新统计还没归本进程所有的叶子 */
+        int pending = 0;
+        for (int k = 0; k < dir->leaf_count; k++) {
+            if (dir->leaves[k]->owner != process_index) pending++;
+        }
+        WS_ATOMIC_STORE(&dir->owner, process_index);
+        WS_ATOMIC_STORE_RELEASE(&proc->cow_pending, pending);
+        return dir;
+    }
+
+    WSClockPageDir* copy = (WSClockPageDir*)table_alloc(env->arena, dir_bytes(dir->leaf_count));
+    if (!copy) return 0;
+    copy->refcount = 1;
+    copy->owner = process_index;
+    copy->leaf_count = dir->leaf_count;
+    for (int k = 0; k < dir->leaf_count; k++) {
+        WSClockLeaf* leaf = dir->leaves[k];
+        leaf->refcount++;
+        WS_ATOMIC_STORE(&leaf->owner, -1);
+        copy->leaves[k] = leaf;
+    }
+    dir->refcount--;
+    env->cow_dir_copies++;
+    WS_ATOMIC_STORE_RELEASE(&proc->page_dir, copy);
+    WS_ATOMIC_STORE(&proc->cow_pending, copy->leaf_count);
+    return copy;
+}
+
+static WSClockLeaf* leaf_for_write_locked(WSClockEnvironment* env, Process* proc, WSClockPageDir* dir,
+                                          int process_index, int k)
+{
+    WSClockLeaf* leaf = dir->leaves[k];
+    if (leaf->owner == process_index) return leaf;
+    if (leaf->refcount == 1) {
+        WS_ATOMIC_STORE(&leaf->owner, process_index);
+        WS_ATOMIC_STORE_RELEASE(&proc->cow_pending, proc->cow_pending - 1);
+        return leaf;
+    }
+
+    WSClockLeaf* copy = leaf_alloc(env->arena);
+    if (!copy) return 0;
+    memcpy(copy->pages, leaf->pages, sizeof(Page) * WSCLOCK_LEAF_PAGES);
+    copy->owner = process_index;
+    leaf->refcount--;
+    env->cow_leaf_copies++;
+    WS_ATOMIC_STORE_RELEASE(&dir->leaves[k], copy);
+    WS_ATOMIC_STORE_RELEASE(&proc->cow_pending, proc->cow_pending - 1);
+    return copy;
+}
+
+/*
+ * 取得可写的页表项：整张页表都归本进程所有(cow_pending 为0)时与只读访问相同；
+ * 否则检查目录和叶子的 owner，必要时在 cow_lock 内完成写时复制。内存不足时返回NULL
+ */
+static Page* page_for_write(WSClockEnvironment* env, Process* proc, int process_index, int page_index)
+{
+    if (WS_ATOMIC_LOAD_ACQUIRE(&proc->cow_pending) == 0) {
+        return wsclock_page(proc, page_index);
+    }
+
+    int k = page_index >> WSCLOCK_LEAF_SHIFT;
+    WSClockPageDir* dir = WS_ATOMIC_LOAD_ACQUIRE(&proc->page_dir);
+    WSClockLeaf* leaf = 0;
+    if (WS_ATOMIC_LOAD(&dir->owner) == process_index) {
+        leaf = WS_ATOMIC_LOAD_ACQUIRE(&dir->leaves[k]);
+        if (WS_ATOMIC_LOAD(&leaf->owner) != process_index) {
+            leaf = 0;
+        }
+    }
+    if (!leaf) {
+        ws_spin_lock(&env->cow_lock);
+        dir = dir_for_write_locked(env, proc, process_index);
+        leaf = dir ? leaf_for_write_locked(env, proc, dir, process_index, k) : 0;
+        ws_spin_unlock(&env->cow_lock);
+        if (!leaf) return 0;
+    }
+    return &leaf->pages[page_index & (WSCLOCK_LEAF_PAGES - 1)];
+}
+
+/* 只读访问：与写时复制并发时用 acquire 读取指针 */
+static Page* page_for_read(Process* proc, int page_index)
+{
+    WSClockPageDir* dir = WS_ATOMIC_LOAD_ACQUIRE(&proc->page_dir);
+    WSClockLeaf* leaf = WS_ATOMIC_LOAD_ACQUIRE(&dir->leaves[page_index >> WSCLOCK_LEAF_SHIFT]);
+    return &leaf->pages[page_index & (WSCLOCK_LEAF_PAGES - 1)];
 }
 
 /*
  * 访问某个页面：如果不在工作集，则进行置换；
  * 如果在工作集，则更新引用位、时间戳等
  */
-void wsclock_access_page(WSClockEnvironment* env, 
-                         int process_index, 
-                         int page_to_access)
+int wsclock_access_page(WSClockEnvironment* env, 
+                        int process_index, 
+                        int page_to_access)
 {
+    return wsclock_access_page_ex(env, process_index, page_to_access, 0, 0);
+}
+
+int wsclock_access_page_ex(WSClockEnvironment* env,
+                           int process_index,
+                           int page_to_access,
+                           int is_write,
+                           int* victim_page)
+{
+    if (victim_page) {
+        *victim_page = -1;
+    }
     if (!env || process_index < 0 || process_index >= env->process_count) {
-        return;
+        return WSCLOCK_ACCESS_INVALID;
     }
 
     Process* proc = &env->processes[process_index];
     if (!proc->active) {
-        return; /* 如果进程不活跃，忽略访问 */
+        return WSCLOCK_ACCESS_INVALID; /* 如果进程不活跃，忽略访问 */
     }
 
-    if (!proc->page_table || page_to_access < 0 || page_to_access >= proc->page_count) {
-        return;
+    if (!proc->page_dir || page_to_access < 0 || page_to_access >= proc->page_count) {
+        return WSCLOCK_ACCESS_INVALID;
     }
 
-    proc->clock++; /* 模拟进程时钟递增 */
+    WSCLOCK_STATS_START(stats_start);
 
-    Page* page = &proc->page_table[page_to_access];
-    if (page->in_working_set) {
-        /* 已在工作集中：更新引用位、时间戳 */
-        page->referenced = 1;
-        page->age = proc->clock;
-    } else {
-        /* 缺页，记录 */
-        log_msg(env, "Page fault occurred. Replacing a page if WS is full.");
-
-        /* 检查工作集是否已满 */
-        int i;
-        int count_in_ws = 0;
-        for (i = 0; i < proc->page_count; i++) {
-            if (proc->page_table[i].in_working_set) {
-                count_in_ws++;
-            }
+    /* 命中也要写引用位与时间戳，先取得可写的页表项(fork 后在这里写时复制) */
+    Page* page = page_for_write(env, proc, process_index, page_to_access);
+    if (!page) {
+        return WSCLOCK_ACCESS_INVALID;
+    }
+
+    /* 模拟进程时钟递增(多线程下原子递增，每次访问得到唯一的时间戳) */
+    unsigned long now = WS_ATOMIC_FETCH_ADD(&proc->clock, 1) + 1;
+
+    if (WS_ATOMIC_LOAD(&page->in_working_set)) {
+        /* 已在工作集中：更新引用位、时间戳(无锁，引用位可能被扫描线程并发清零) */
+        WS_ATOMIC_STORE(&page->referenced, 1);
+        ws_atomic_max_ulong(&page->age, now);
+        if (is_write) {
+            WS_ATOMIC_STORE(&page->modified, 1);
+        }
+        WSCLOCK_STATS_END(WSCLOCK_OP_ACCESS_HIT, stats_start);
+        return WSCLOCK_ACCESS_HIT;
+    }
+
+    /* 缺页，记录 */
+    log_msg(env, "Page fault occurred. Replacing a page if WS is full.");
+
+    ws_spin_lock(&proc->evict_lock);
+
+    /* 等锁期间其他线程可能已装入该页，此时按命中处理 */
+    if (WS_ATOMIC_LOAD(&page->in_working_set)) {
+        WS_ATOMIC_STORE(&page->referenced, 1);
+        ws_atomic_max_ulong(&page->age, now);
+        if (is_write) {
+            WS_ATOMIC_STORE(&page->modified, 1);
         }
+        ws_spin_unlock(&proc->evict_lock);
+        WSCLOCK_STATS_END(WSCLOCK_OP_ACCESS_HIT, stats_start);
+        return WSCLOCK_ACCESS_HIT;
+    }
+
+    int result = WSCLOCK_ACCESS_FAULT;
 
-        /* 工作集已满，需要置换 */
-        if (count_in_ws >= proc->working_set_size) {
-            Page* victim = find_victim_page(proc);
-            if (victim) {
-                victim->in_working_set = 0;
-                victim->referenced = 0;
-                victim->age = 0;
-                victim->modified = 0;
+    /* 工作集已满，需要置换 */
+    if (proc->ws_count >= proc->working_set_size) {
+        int victim_index = find_victim_page(proc);
+        Page* victim = victim_index >= 0 ? page_for_write(env, proc, process_index, victim_index) : 0;
+        if (victim) {
+            result |= WSCLOCK_ACCESS_EVICT;
+            int dirty = WS_ATOMIC_XCHG(&victim->modified, 0);
+            WSClockSharedPage* sp = shared_page_of(env, proc, victim_index);
+            if (sp) {
+                /* 共享页：脏状态记在共享页上，最后一个进程释放时才写回 */
+                if (dirty) {
+                    WS_ATOMIC_STORE(&sp->dirty, 1);
+                }
+                if (WS_ATOMIC_FETCH_ADD(&sp->refcount, -1) == 1 && WS_ATOMIC_XCHG(&sp->dirty, 0)) {
+                    result |= WSCLOCK_ACCESS_WRITEBACK;
+                }
+            } else if (dirty) {
+                result |= WSCLOCK_ACCESS_WRITEBACK; /* 脏页需要先写回 */
             }
+            if (victim_page) {
+                *victim_page = victim_index;
+            }
+            WS_ATOMIC_STORE(&victim->in_working_set, 0);
+            WS_ATOMIC_STORE(&victim->referenced, 0);
+            WS_ATOMIC_STORE(&victim->age, 0UL);
+            proc->ws_count--;
         }
+    }
 
-        /* 将目标页加入工作集 */
-        page->in_working_set = 1;
-        page->referenced = 1;
-        page->modified = 0; /* 本示例中不做写回处理 */
-        page->age = proc->clock;
+    /* 共享页已被其他进程的工作集引用时仍驻留内存，只是次缺页 */
+    WSClockSharedPage* shared = shared_page_of(env, proc, page_to_access);
+    if (shared && WS_ATOMIC_FETCH_ADD(&shared->refcount, 1) > 0) {
+        result |= WSCLOCK_ACCESS_MINOR;
+        WSCLOCK_STATS_ADD(proc->counters.minor_faults, 1);
     }
+    WSCLOCK_STATS_ADD(proc->counters.faults, 1);
+    if (result & WSCLOCK_ACCESS_EVICT) {
+        WSCLOCK_STATS_ADD(proc->counters.evictions, 1);
+    }
+    if (result & WSCLOCK_ACCESS_WRITEBACK) {
+        WSCLOCK_STATS_ADD(proc->counters.writebacks, 1);
+    }
+
+    /* 将目标页加入工作集，写访问装入后即为脏页 */
+    WS_ATOMIC_STORE(&page->modified, is_write ? 1 : 0);
+    WS_ATOMIC_STORE(&page->referenced, 1);
+    WS_ATOMIC_STORE(&page->age, now);
+    WS_ATOMIC_STORE(&page->in_working_set, 1);
+    proc->ws_count++;
+
+    ws_spin_unlock(&proc->evict_lock);
+    WSCLOCK_STATS_END(WSCLOCK_OP_ACCESS_FAULT, stats_start);
+    return result;
 }
 
 /*
- * 简化的WSClock扫描：找一个可替换的页面(未被引用或最老)
+ * 简化的WSClock扫描：找一个可替换的页面(未被引用或最老)，返回页号，没有时返回-1
  */
-static Page* find_victim_page(Process* proc)
+static int find_victim_page(Process* proc)
 {
-    Page* victim = 0;
+    int victim = -1;
     unsigned long min_age = (unsigned long)-1;
+    WSCLOCK_STATS_START(stats_start);
+    WSCLOCK_STATS_ADD(proc->counters.victim_searches, 1);
+    WSCLOCK_STATS_ADD(proc->counters.victim_pages_scanned, (unsigned long long)proc->page_count);
+
+    /* 调用方持有 evict_lock；引用位和时间戳仍可能被命中路径并发更新，需原子读取 */
 
     /* 第一轮找 reference=0 中 age 最小的 */
     for (int i = 0; i < proc->page_count; i++) {
-        if (!proc->page_table[i].in_working_set) 
+        Page* p = page_for_read(proc, i);
+        if (!WS_ATOMIC_LOAD(&p->in_working_set)) 
             continue;
-        if (proc->page_table[i].referenced == 0 && proc->page_table[i].age < min_age) {
-            victim = &proc->page_table[i];
-            min_age = proc->page_table[i].age;
+        unsigned long age = WS_ATOMIC_LOAD(&p->age);
+        if (WS_ATOMIC_LOAD(&p->referenced) == 0 && age < min_age) {
+            victim = i;
+            min_age = age;
         }
     }
 
     /* 如果找不到则找 age 最小的(即最先被访问的页面) */
-    if (!victim) {
+    if (victim < 0) {
+        WSCLOCK_STATS_ADD(proc->counters.victim_pages_scanned, (unsigned long long)proc->page_count);
         for (int i = 0; i < proc->page_count; i++) {
-            if (!proc->page_table[i].in_working_set) 
+            Page* p = page_for_read(proc, i);
+            if (!WS_ATOMIC_LOAD(&p->in_working_set)) 
                 continue;
-            if (proc->page_table[i].age < min_age) {
-                victim = &proc->page_table[i];
-                min_age = proc->page_table[i].age;
+            unsigned long age = WS_ATOMIC_LOAD(&p->age);
+            if (age < min_age) {
+                victim = i;
+                min_age = age;
             }
         }
     }
 
+    WSCLOCK_STATS_END(WSCLOCK_OP_FIND_VICTIM, stats_start);
     return victim;
 }
 
+/*
+ * 查找进程页面映射到的共享页，私有页返回NULL
+ */
+static WSClockSharedPage* shared_page_of(WSClockEnvironment* env, Process* proc, int page_index)
+{
+    if (!env->shared || !proc->shared_map) {
+        return 0;
+    }
+    int g = proc->shared_map[page_index];
+    return g >= 0 ? &env->shared->pages[g] : 0;
+}
+
 /*
  * 周期性清理函数：可以在调度循环中调用
  * 将被引用位(reference)清零，以模拟操作系统在一定时间间隔内“衰减”访问位
@@ -119,15 +426,107 @@ void wsclock_periodic_scan(WSClockEnvironment* env, int process_index)
         return;
     }
     Process* proc = &env->processes[process_index];
-    if (!proc->active) {
+    if (!proc->active || !proc->page_dir) {
         return;
     }
-    /* 清理引用位 */
+    WSCLOCK_STATS_START(stats_start);
+    int cleared = 0;
+
+    /* 清理引用位(已经为0的不再写，减少与命中路径争用缓存行，也避免无谓的写时复制) */
     for (int i = 0; i < proc->page_count; i++) {
-        if (proc->page_table[i].in_working_set) {
-            proc->page_table[i].referenced = 0;
+        Page* p = page_for_read(proc, i);
+        if (WS_ATOMIC_LOAD(&p->in_working_set) && WS_ATOMIC_LOAD(&p->referenced)) {
+            p = page_for_write(env, proc, process_index, i);
+            if (p) {
+                WS_ATOMIC_STORE(&p->referenced, 0);
+                cleared++;
+            }
+        }
+    }
+    (void)cleared;
+    WSCLOCK_STATS_ADD(proc->counters.scans, 1);
+    WSCLOCK_STATS_ADD(proc->counters.scan_pages, (unsigned long long)proc->page_count);
+    WSCLOCK_STATS_ADD(proc->counters.bits_cleared, (unsigned long long)cleared);
+    WSCLOCK_STATS_END(WSCLOCK_OP_PERIODIC_SCAN, stats_start);
+}
+
+/*
+ * 增量扫描：从游标处开始，最多扫描budget个页表项后保存游标返回。
+ * 一次调用最多扫描一整轮(page_count项)，避免预算过大时重复扫描同一页。
+ */
+int wsclock_periodic_scan_budget(WSClockEnvironment* env,
+                                 int process_index,
+                                 int budget,
+                                 WSClockScanStats* stats)
+{
+    if (!env || process_index < 0 || process_index >= env->process_count) {
+        return -1;
+    }
+    Process* proc = &env->processes[process_index];
+    if (!proc->active || !proc->page_dir || proc->page_count <= 0) {
+        return -1;
+    }
+
+    unsigned long long start_ns = stats ? wsclock_now_ns() : 0;
+    WSCLOCK_STATS_START(stats_start);
+
+    if (budget > proc->page_count) {
+        budget = proc->page_count;
+    }
+    int cursor = proc->scan_cursor;
+    if (cursor < 0 || cursor >= proc->page_count) {
+        cursor = 0;
+    }
+
+    int scanned = 0;
+    int cleared = 0;
+    int pass_completed = 0;
+    while (scanned < budget) {
+        Page* page = page_for_read(proc, cursor);
+        if (WS_ATOMIC_LOAD(&page->in_working_set) && WS_ATOMIC_LOAD(&page->referenced)) {
+            /* 交换而非直接写0，便于统计实际清掉了多少引用位 */
+            page = page_for_write(env, proc, process_index, cursor);
+            if (page && WS_ATOMIC_XCHG(&page->referenced, 0)) {
+                cleared++;
+            }
+        }
+        scanned++;
+        if (++cursor >= proc->page_count) {
+            cursor = 0;
+            proc->scan_passes++;
+            pass_completed = 1;
         }
     }
+    proc->scan_cursor = cursor;
+    WSCLOCK_STATS_ADD(proc->counters.scans, 1);
+    WSCLOCK_STATS_ADD(proc->counters.scan_pages, (unsigned long long)scanned);
+    WSCLOCK_STATS_ADD(proc->counters.bits_cleared, (unsigned long long)cleared);
+    WSCLOCK_STATS_END(WSCLOCK_OP_SCAN_BUDGET, stats_start);
+
+    if (stats) {
+        stats->pages_scanned = scanned;
+        stats->bits_cleared = cleared;
+        stats->cursor = cursor;
+        stats->pass_completed = pass_completed;
+        stats->passes = proc->scan_passes;
+        stats->progress = (double)cursor / (double)proc->page_count;
+        stats->elapsed_ns = wsclock_now_ns() - start_ns;
+    }
+    return scanned;
+}
+
+/*
+ * 每次预算 = ceil(page_count / period_ticks)，至少为1
+ */
+int wsclock_scan_budget_for_period(int page_count, int period_ticks)
+{
+    if (page_count <= 0) {
+        return 0;
+    }
+    if (period_ticks <= 1) {
+        return page_count;
+    }
+    return (page_count + period_ticks - 1) / period_ticks;
 }
 
 /*
@@ -141,9 +540,20 @@ static void log_msg(WSClockEnvironment* env, const char* msg)
 }
 
 /*
- * 清理函数(示例中仅空实现)
+ * 清理函数：释放生命周期接口扩容出的进程数组，并销毁交给环境的分配器
+ * (从 arena 切出的进程数组与页表随之一起释放)；不用 arena 时页表由调用方释放
  */
 void wsclock_cleanup(WSClockEnvironment* env)
 {
-    
+    if (!env) return;
+    /* 生命周期接口用 malloc 扩容的进程数组(从 arena 分配的随 arena 一起释放) */
+    if (env->processes_owned && !env->arena) {
+        free(env->processes);
+        env->processes = 0;
+        env->processes_owned = 0;
+    }
+    if (env->arena) {
+        wsclock_arena_destroy(env->arena);
+        env->arena = 0;
+    }
 }
\ No newline at end of file
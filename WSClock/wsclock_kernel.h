@@ -21,18 +21,75 @@ typedef struct Page {
     int in_working_set;   /* 是否为工作集成员 */
 } Page;
 
+/*
+ * 两级页表：页表目录指向若干叶子，每个叶子保存连续 WSCLOCK_LEAF_PAGES 个页表项。
+ * 目录和叶子都带引用计数，fork 时子进程直接共享父进程的目录(O(1))，
+ * 第一次写入时才复制目录(只复制叶子指针)，再按叶子粒度写时复制，只复制实际被写的叶子。
+ *  - owner: 可以不加检查直接写入的进程下标；共享或尚未被某个进程认领时为 -1
+ */
+#define WSCLOCK_LEAF_SHIFT 6
+#define WSCLOCK_LEAF_PAGES (1 << WSCLOCK_LEAF_SHIFT)
+
+typedef struct WSClockLeaf {
+    Page* pages;          /* WSCLOCK_LEAF_PAGES 项，单独分配，大小正好是 2 的幂 */
+    int refcount;         /* 引用该叶子的目录数 */
+    int owner;
+} WSClockLeaf;
+
+typedef struct WSClockPageDir {
+    int refcount;         /* 共享该目录的进程数 */
+    int owner;
+    int leaf_count;
+    WSClockLeaf* leaves[1];   /* 实际长度为 leaf_count */
+} WSClockPageDir;
+
+/*
+ * 进程级计数器(见 wsclock_stats.h，编译时 WSCLOCK_STATS=0 则不更新)
+ */
+typedef struct WSClockProcCounters {
+    unsigned long long hits;                 /* 不在热路径上累加，由 wsclock_stats_process 推算 */
+    unsigned long long faults;               /* 含次缺页 */
+    unsigned long long minor_faults;
+    unsigned long long evictions;
+    unsigned long long writebacks;
+    unsigned long long victim_searches;      /* find_victim_page 调用次数 */
+    unsigned long long victim_pages_scanned; /* find_victim_page 检查的页表项数 */
+    unsigned long long scans;                /* periodic_scan(_budget) 调用次数 */
+    unsigned long long scan_pages;           /* 周期扫描检查的页表项数 */
+    unsigned long long bits_cleared;         /* 周期扫描清掉的引用位数 */
+    unsigned long clock_base;                /* wsclock_init 时的进程时钟，用于推算访问次数 */
+} WSClockProcCounters;
+
 /*
  * 进程结构：包含页表、工作集大小等信息
  */
 typedef struct Process {
     int process_id;
-    Page* page_table;
+    WSClockPageDir* page_dir; /* 页表(见 wsclock_page)，由 wsclock_page_table_init 分配 */
     int page_count;       /* 进程总页数 */
     int working_set_size; /* 工作集容量限制 */
-    unsigned long clock;  /* 模拟进程内(或全局)时钟 */
+    unsigned long clock;  /* 模拟进程内(或全局)时钟，并发访问时原子递增 */
     int active;           /* 是否处于可调度状态(模拟多进程管理) */
+    int scan_cursor;      /* 增量扫描的游标：下一次从该页开始扫描 */
+    unsigned long scan_passes; /* 增量扫描已完成的整轮数 */
+    int ws_count;         /* 当前工作集中的页数(由wsclock_init统计，置换路径维护) */
+    int evict_lock;       /* 缺页/置换路径的自旋锁，串行化同一进程的置换 */
+    int* shared_map;      /* 页号 -> 共享页表下标，-1 为私有页；NULL 表示全部私有(见 wsclock_shared.h) */
+    int cow_pending;      /* 尚未归本进程所有的目录/叶子数(上界)，为0时写页表项不必检查写时复制 */
+    WSClockProcCounters counters; /* 插桩计数器，由wsclock_init清零 */
 } Process;
 
+struct WSClockSharedTable;
+struct WSClockArena;
+
+/*
+ * 读取进程的第 i 页页表项(只读；写入须经过 wsclock_kernel.c 内部的写时复制检查)
+ */
+static inline Page* wsclock_page(const Process* proc, int i)
+{
+    return &proc->page_dir->leaves[i >> WSCLOCK_LEAF_SHIFT]->pages[i & (WSCLOCK_LEAF_PAGES - 1)];
+}
+
 /*
  * 整个WSClock环境：管理多个进程以及输出回调
  */
@@ -40,22 +97,79 @@ typedef struct WSClockEnvironment {
     Process* processes;
     int process_count;
     WSClockLogCallback logger;
+    struct WSClockSharedTable* shared; /* 全局共享页表，可为NULL(由 wsclock_shared_attach 设置) */
+    struct WSClockArena* arena;        /* 页表等元数据的分配器，可为NULL(由 wsclock_arena_attach 设置，
+                                          wsclock_cleanup 时销毁) */
+    int process_capacity;              /* processes 数组的容量(见 wsclock_lifecycle.h) */
+    int processes_owned;               /* processes 是否由生命周期接口扩容时重新分配 */
+    int cow_lock;                      /* 串行化写时复制(复制期间从 arena 分配内存) */
+    unsigned long cow_dir_copies;      /* 写时复制的次数：复制的目录数与叶子数 */
+    unsigned long cow_leaf_copies;
 } WSClockEnvironment;
 
+/*
+ * 分配进程的页表：page_count 项全部不在工作集中，page_id 依次编号
+ * 参数:
+ *   - arena: 可为NULL(使用 malloc)；须与之后 wsclock_arena_attach 给环境的分配器相同，
+ *     写时复制时从环境的分配器分配新叶子
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或内存不足
+ */
+int wsclock_page_table_init(Process* proc, struct WSClockArena* arena, int page_count);
+
+/*
+ * 释放进程对页表的引用：目录/叶子的引用计数降为0时才真正释放
+ */
+void wsclock_page_table_release(Process* proc, struct WSClockArena* arena);
+
 /*
  * 初始化WSClock环境
+ * 会根据各进程页表统计ws_count、复位置换锁并清零计数器，因此应在页表初始化完成后调用
  */
 void wsclock_init(WSClockEnvironment* env, 
                   Process* processes,
                   int process_count,
                   WSClockLogCallback logger);
 
+/*
+ * 访问结果标志(按位组合)：
+ *  - WSCLOCK_ACCESS_HIT: 页面已在工作集中
+ *  - WSCLOCK_ACCESS_FAULT: 缺页，页面被装入工作集
+ *  - WSCLOCK_ACCESS_EVICT: 缺页时工作集已满，置换出一个页面
+ *  - WSCLOCK_ACCESS_WRITEBACK: 被置换的页面是脏页，需要写回
+ *  - WSCLOCK_ACCESS_MINOR: 与 FAULT 同时出现，缺页的是共享页且已因其他进程驻留内存，
+ *    只需建立映射、不需要读入(次缺页)
+ *  - WSCLOCK_ACCESS_INVALID: 参数非法、进程不活跃或写时复制时内存不足，访问被忽略
+ */
+#define WSCLOCK_ACCESS_HIT        0
+#define WSCLOCK_ACCESS_FAULT      0x1
+#define WSCLOCK_ACCESS_EVICT      0x2
+#define WSCLOCK_ACCESS_WRITEBACK  0x4
+#define WSCLOCK_ACCESS_MINOR      0x8
+#define WSCLOCK_ACCESS_INVALID    (-1)
+
 /*
  * 对指定进程访问page_to_access页，并根据需要触发WSClock置换
+ * 线程安全：多个线程可同时访问同一进程。命中路径只做原子更新、不加锁；
+ * 缺页路径在进程级自旋锁内完成置换，与后台扫描线程可并发运行。
+ * 返回值: WSCLOCK_ACCESS_* 标志组合
  */
-void wsclock_access_page(WSClockEnvironment* env, 
-                         int process_index, 
-                         int page_to_access);
+int wsclock_access_page(WSClockEnvironment* env, 
+                        int process_index, 
+                        int page_to_access);
+
+/*
+ * 带读写类型的访问：is_write 非0时将页面置为脏页，置换脏页时返回 WSCLOCK_ACCESS_WRITEBACK
+ * 参数:
+ *   - victim_page: 可为NULL；发生置换时写入被置换的页号，否则写入-1
+ * 返回值: WSCLOCK_ACCESS_* 标志组合
+ */
+int wsclock_access_page_ex(WSClockEnvironment* env,
+                           int process_index,
+                           int page_to_access,
+                           int is_write,
+                           int* victim_page);
 
 /*
  * 执行对目标进程的“周期性扫描/清理”操作，可与调度循环结合
@@ -64,7 +178,42 @@ void wsclock_access_page(WSClockEnvironment* env,
 void wsclock_periodic_scan(WSClockEnvironment* env, int process_index);
 
 /*
- * 释放WSClock环境(示例中可简单处理)
+ * 增量扫描的统计信息：每次调用后填写本次的扫描进度与耗时
+ */
+typedef struct WSClockScanStats {
+    int pages_scanned;        /* 本次扫描的页表项数(不超过预算) */
+    int bits_cleared;         /* 本次清零的引用位个数 */
+    int cursor;               /* 扫描结束后的游标位置 */
+    int pass_completed;       /* 本次是否完成了一整轮扫描 */
+    unsigned long passes;     /* 累计完成的整轮数 */
+    double progress;          /* 当前一轮的完成比例 [0,1) */
+    unsigned long long elapsed_ns; /* 本次调用耗时(纳秒) */
+} WSClockScanStats;
+
+/*
+ * 增量(带预算)的周期性扫描：每次最多扫描budget个页表项，
+ * 并从上次保存的游标(scan_cursor)处继续，单次调用的开销与进程总页数无关。
+ * 引用位以原子方式清零，可由后台线程调用；同一进程的游标同一时刻只应由一个扫描者推进。
+ * 参数:
+ *   - stats: 可为NULL；非NULL时填写本次的扫描进度与耗时
+ * 返回值:
+ *   - 本次扫描的页表项数
+ *   - -1: 参数非法或进程不活跃
+ */
+int wsclock_periodic_scan_budget(WSClockEnvironment* env,
+                                 int process_index,
+                                 int budget,
+                                 WSClockScanStats* stats);
+
+/*
+ * 计算均匀摊开扫描所需的每次预算：
+ * 希望每period_ticks次调用完成一整轮时，每次应扫描 ceil(page_count / period_ticks) 页
+ */
+int wsclock_scan_budget_for_period(int page_count, int period_ticks);
+
+/*
+ * 释放WSClock环境：销毁 wsclock_arena_attach 交给环境的分配器，
+ * 并释放生命周期接口扩容出的进程数组(不用 arena 时，页表须先由 wsclock_process_exit 释放)
  */
 void wsclock_cleanup(WSClockEnvironment* env);
 
@@ -0,0 +1,146 @@
+#include <stdlib.h>
+#include <string.h>
+#include "wsclock_lifecycle.h"
+#include "wsclock_arena.h"
+#include "wsclock_atomic.h"
+#include "wsclock_shared.h"
+
+/* 进程数组：有分配器时从分配器分配，否则用 malloc */
+static Process* procs_alloc(WSClockEnvironment* env, int capacity)
+{
+    size_t size = sizeof(Process) * (size_t)capacity;
+    return (Process*)(env->arena ? wsclock_arena_alloc(env->arena, size) : calloc(1, size));
+}
+
+static int ensure_slot(WSClockEnvironment* env)
+{
+    /* 优先复用已退出进程的槽位 */
+    for (int i = 0; i < env->process_count; i++) {
+        if (!env->processes[i].active && !env->processes[i].page_dir) return i;
+    }
+    if (env->process_count < env->process_capacity) return env->process_count++;
+
+    int capacity = env->process_capacity < 4 ? 8 : env->process_capacity * 2;
+    Process* grown = procs_alloc(env, capacity);
+    if (!grown) return -1;
+    if (env->process_count > 0) {
+        memcpy(grown, env->processes, sizeof(Process) * (size_t)env->process_count);
+    }
+    if (env->processes_owned) {
+        if (env->arena) {
+            wsclock_arena_free(env->arena, env->processes, sizeof(Process) * (size_t)env->process_capacity);
+        } else {
+            free(env->processes);
+        }
+    }
+    env->processes = grown;
+    env->process_capacity = capacity;
+    env->processes_owned = 1;
+    return env->process_count++;
+}
+
+/* 槽位是新扩出来的(而不是复用的)时，失败后把 process_count 退回去 */
+static void drop_slot(WSClockEnvironment* env, int index)
+{
+    memset(&env->processes[index], 0, sizeof(Process));
+    if (index == env->process_count - 1) env->process_count--;
+}
+
+int wsclock_process_spawn(WSClockEnvironment* env, int process_id, int page_count, int working_set_size)
+{
+    if (!env || page_count <= 0) return -1;
+    int index = ensure_slot(env);
+    if (index < 0) return -1;
+
+    Process* proc = &env->processes[index];
+    memset(proc, 0, sizeof(Process));
+    if (wsclock_page_table_init(proc, env->arena, page_count) != 0) {
+        drop_slot(env, index);
+        return -1;
+    }
+    proc->process_id = process_id;
+    proc->working_set_size = working_set_size;
+    proc->active = 1;
+    return index;
+}
+
+/* 进程工作集中的每个共享页引用计数加 delta(只看映射过共享页的范围) */
+static void shared_adjust(WSClockEnvironment* env, Process* proc, int delta)
+{
+    if (!env->shared || !proc->shared_map || !proc->page_dir) return;
+    int first, end;
+    wsclock_shared_map_span(proc, &first, &end);
+    for (int i = first; i < end; i++) {
+        int g = proc->shared_map[i];
+        if (g >= 0 && wsclock_page(proc, i)->in_working_set) {
+            env->shared->pages[g].refcount += delta;
+        }
+    }
+}
+
+void wsclock_process_exit(WSClockEnvironment* env, int process_index)
+{
+    if (!env || process_index < 0 || process_index >= env->process_count) return;
+    Process* proc = &env->processes[process_index];
+    if (!proc->page_dir) return;
+
+    shared_adjust(env, proc, -1);
+    wsclock_page_table_release(proc, env->arena);
+    wsclock_shared_unmap(proc);
+    proc->active = 0;
+    proc->ws_count = 0;
+}
+
+int wsclock_process_fork(WSClockEnvironment* env, int parent_index, int child_process_id)
+{
+    if (!env || parent_index < 0 || parent_index >= env->process_count) return -1;
+    if (!env->processes[parent_index].active || !env->processes[parent_index].page_dir) return -1;
+
+    int index = ensure_slot(env);
+    if (index < 0) return -1;
+    /* ensure_slot 可能重新分配了进程数组 */
+    Process* parent = &env->processes[parent_index];
+    Process* child = &env->processes[index];
+    memset(child, 0, sizeof(Process));
+
+    /* 共享目录：双方的 owner 都失效，下一次写时各自走写时复制 */
+    WSClockPageDir* dir = parent->page_dir;
+    ws_spin_lock(&env->cow_lock);
+    dir->refcount++;
+    WS_ATOMIC_STORE(&dir->owner, -1);
+    ws_spin_unlock(&env->cow_lock);
+
+    child->process_id = child_process_id;
+    child->page_dir = dir;
+    child->page_count = parent->page_count;
+    child->working_set_size = parent->working_set_size;
+    child->clock = WS_ATOMIC_LOAD(&parent->clock);
+    child->active = 1;
+    child->scan_cursor = parent->scan_cursor;
+    child->ws_count = parent->ws_count;
+    child->counters.clock_base = child->clock;
+    wsclock_shared_map_inherit(child, parent);
+    /* 双方都要重新认领目录(认领时再精确统计未归属的叶子) */
+    parent->cow_pending = dir->leaf_count + 1;
+    child->cow_pending = dir->leaf_count + 1;
+    shared_adjust(env, child, 1);
+    return index;
+}
+
+void wsclock_page_table_usage(const WSClockEnvironment* env, long* mapped, long* allocated)
+{
+    long m = 0;
+    double a = 0.0;
+    for (int p = 0; env && p < env->process_count; p++) {
+        const Process* proc = &env->processes[p];
+        const WSClockPageDir* dir = proc->page_dir;
+        if (!dir) continue;
+        m += proc->page_count;
+        /* 目录被 dir->refcount 个进程共享，叶子被 leaf->refcount 个目录共享，按比例分摊 */
+        for (int k = 0; k < dir->leaf_count; k++) {
+            a += (double)WSCLOCK_LEAF_PAGES / ((double)dir->refcount * (double)dir->leaves[k]->refcount);
+        }
+    }
+    if (mapped) *mapped = m;
+    if (allocated) *allocated = (long)(a + 0.5);
+}
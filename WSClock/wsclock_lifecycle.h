@@ -0,0 +1,56 @@
+#ifndef WSCLOCK_LIFECYCLE_H
+#define WSCLOCK_LIFECYCLE_H
+
+#include "wsclock_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 进程生命周期：创建、退出与 fork
+ *  - 页表是两级结构(目录 -> 叶子，见 WSClockPageDir)。fork 时子进程与父进程共享同一个目录，
+ *    只把目录的引用计数加1，开销与页数无关；之后任一方第一次写某个叶子时才复制该叶子
+ *    (WSCLOCK_LEAF_PAGES 页)，复制次数记在 env->cow_dir_copies / cow_leaf_copies
+ *  - 页表从环境的分配器分配(env->arena 为NULL时用 malloc)
+ *  - 这些接口不能与 wsclock_access_page / wsclock_periodic_scan 并发调用；
+ *    扩容时 env->processes 可能被重新分配，调用方不要长期保存 Process 指针
+ *  - 退出的进程 active 为0、page_dir 为NULL，其槽位会被之后创建的进程复用，
+ *    所以进程下标不是唯一的进程标识，需要时用 process_id 区分
+ */
+
+/*
+ * 创建进程：页面全不在工作集中
+ * 返回值:
+ *   - >=0: 新进程的下标
+ *   - -1: 参数非法或内存不足
+ */
+int wsclock_process_spawn(WSClockEnvironment* env, int process_id, int page_count, int working_set_size);
+
+/*
+ * 进程退出：释放页表引用与 shared_map，工作集中的共享页引用计数减1
+ */
+void wsclock_process_exit(WSClockEnvironment* env, int process_index);
+
+/*
+ * fork：子进程继承父进程的工作集(写时复制共享页表)、工作集容量、时钟与扫描游标，
+ * 计数器从0开始；父进程的 shared_map 按引用计数共享(不复制)，工作集中的共享页引用计数加1，
+ * 这一步只遍历映射过共享页的页号范围，没有共享段时 fork 的开销与页数无关
+ * 返回值:
+ *   - >=0: 子进程的下标
+ *   - -1: 父进程不存在或内存不足
+ */
+int wsclock_process_fork(WSClockEnvironment* env, int parent_index, int child_process_id);
+
+/*
+ * 页表占用(单位：页表项)：
+ *  - mapped: 各活动进程页数之和，即不共享时需要的页表项数
+ *  - allocated: 实际分配的叶子所含的页表项数(共享的叶子只算一次)
+ */
+void wsclock_page_table_usage(const WSClockEnvironment* env, long* mapped, long* allocated);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_LIFECYCLE_H */
@@ -0,0 +1,139 @@
+#include <stdlib.h>
+#include <string.h>
+#include "wsclock_mglru.h"
+
+#define GEN_OF(m, seq) (&(m)->gens[(seq) % WSCLOCK_MGLRU_MAX_GENS])
+
+int wsclock_mglru_init(WSClockMglru* mglru, int page_count, int capacity)
+{
+    if (!mglru || page_count <= 0 || capacity <= 0) return -1;
+
+    memset(mglru, 0, sizeof(WSClockMglru));
+    mglru->pages = (WSClockMglruPage*)calloc((size_t)page_count, sizeof(WSClockMglruPage));
+    if (!mglru->pages) return -1;
+    mglru->page_count = page_count;
+    mglru->capacity = capacity;
+    for (int i = 0; i < page_count; i++) {
+        mglru->pages[i].prev = -1;
+        mglru->pages[i].next = -1;
+    }
+    for (int g = 0; g < WSCLOCK_MGLRU_MAX_GENS; g++) {
+        mglru->gens[g].head = -1;
+        mglru->gens[g].tail = -1;
+    }
+    return 0;
+}
+
+/* 加入第 seq 代的链表头 */
+static void gen_push(WSClockMglru* m, int page, unsigned long seq)
+{
+    WSClockMglruGen* gen = GEN_OF(m, seq);
+    WSClockMglruPage* p = &m->pages[page];
+    p->seq = seq;
+    p->prev = -1;
+    p->next = gen->head;
+    if (gen->head >= 0) m->pages[gen->head].prev = page;
+    gen->head = page;
+    if (gen->tail < 0) gen->tail = page;
+    gen->size++;
+}
+
+/* 从所在代的链表中摘除 */
+static void gen_unlink(WSClockMglru* m, int page)
+{
+    WSClockMglruPage* p = &m->pages[page];
+    WSClockMglruGen* gen = GEN_OF(m, p->seq);
+    if (p->prev >= 0) m->pages[p->prev].next = p->next;
+    else gen->head = p->next;
+    if (p->next >= 0) m->pages[p->next].prev = p->prev;
+    else gen->tail = p->prev;
+    p->prev = -1;
+    p->next = -1;
+    gen->size--;
+}
+
+void wsclock_mglru_age(WSClockMglru* mglru)
+{
+    if (!mglru) return;
+    if (mglru->max_seq - mglru->min_seq + 1 < WSCLOCK_MGLRU_MAX_GENS) {
+        mglru->max_seq++;
+        mglru->aged++;
+    }
+}
+
+/*
+ * 从最老一代回收一页，返回页号
+ */
+static int mglru_evict(WSClockMglru* m)
+{
+    for (;;) {
+        WSClockMglruGen* oldest = GEN_OF(m, m->min_seq);
+        if (oldest->size == 0) {
+            /* 最老一代已空：整代退休。驻留页数>0 时 min_seq 不会越过 max_seq */
+            m->min_seq++;
+            continue;
+        }
+
+        int page = oldest->tail;
+        WSClockMglruPage* p = &m->pages[page];
+        m->scanned++;
+        if (p->referenced) {
+            /* 最近被引用过：清引用位，提升到最年轻一代；只有一代时先新建一代 */
+            p->referenced = 0;
+            if (m->min_seq == m->max_seq) {
+                wsclock_mglru_age(m);
+            }
+            gen_unlink(m, page);
+            gen_push(m, page, m->max_seq);
+            m->promoted++;
+            continue;
+        }
+
+        gen_unlink(m, page);
+        p->resident = 0;
+        m->resident--;
+        m->evictions++;
+        return page;
+    }
+}
+
+int wsclock_mglru_access(WSClockMglru* mglru, int page, int* victim_page)
+{
+    if (victim_page) *victim_page = -1;
+    if (!mglru || page < 0 || page >= mglru->page_count) return WSCLOCK_ACCESS_INVALID;
+
+    mglru->refs++;
+    WSClockMglruPage* p = &mglru->pages[page];
+    if (p->resident) {
+        p->referenced = 1;
+        return WSCLOCK_ACCESS_HIT;
+    }
+
+    int result = WSCLOCK_ACCESS_FAULT;
+    mglru->faults++;
+    if (mglru->resident >= mglru->capacity) {
+        int victim = mglru_evict(mglru);
+        if (victim_page) *victim_page = victim;
+        result |= WSCLOCK_ACCESS_EVICT;
+    }
+
+    /* 新装入的页进入最年轻一代 */
+    p->resident = 1;
+    p->referenced = 0;
+    gen_push(mglru, page, mglru->max_seq);
+    mglru->resident++;
+    return result;
+}
+
+int wsclock_mglru_resident(const WSClockMglru* mglru, int page)
+{
+    if (!mglru || page < 0 || page >= mglru->page_count) return 0;
+    return mglru->pages[page].resident;
+}
+
+void wsclock_mglru_free(WSClockMglru* mglru)
+{
+    if (!mglru) return;
+    free(mglru->pages);
+    mglru->pages = 0;
+}
@@ -0,0 +1,86 @@
+#ifndef WSCLOCK_MGLRU_H
+#define WSCLOCK_MGLRU_H
+
+#include "wsclock_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 同时存在的代数上限(与 Linux MGLRU 的 MAX_NR_GENS 相同) */
+#define WSCLOCK_MGLRU_MAX_GENS 4
+
+/*
+ * 多代老化(MGLRU 风格)的单进程置换状态，可替代逐页 age 时间戳：
+ *  - 驻留页挂在至多 WSCLOCK_MGLRU_MAX_GENS 个代链表中，代号 seq 单调递增，
+ *    min_seq 为最老一代，max_seq 为最年轻一代
+ *  - 命中只置引用位，不移动链表，开销 O(1)
+ *  - 老化：新建一代(max_seq++)，所有已有页面整体变老一代，不逐页处理
+ *  - 回收只看最老一代的链表尾：引用位为1的页清零后提升到最年轻一代，
+ *    否则回收；最老一代空了就 min_seq++，不会扫描年轻的页
+ */
+typedef struct WSClockMglruPage {
+    unsigned long seq;        /* 所在代号(仅驻留时有效) */
+    int prev;                 /* 代链表，-1 为空 */
+    int next;
+    unsigned char resident;
+    unsigned char referenced;
+} WSClockMglruPage;
+
+typedef struct WSClockMglruGen {
+    int head;                 /* 最近加入的页 */
+    int tail;                 /* 最早加入的页，回收从这里开始 */
+    int size;
+} WSClockMglruGen;
+
+typedef struct WSClockMglru {
+    WSClockMglruPage* pages;
+    int page_count;
+    int capacity;             /* 工作集容量 */
+    int resident;
+    unsigned long min_seq;
+    unsigned long max_seq;
+    WSClockMglruGen gens[WSCLOCK_MGLRU_MAX_GENS];  /* 按 seq % MAX_GENS 索引 */
+
+    /* 统计 */
+    unsigned long long refs;
+    unsigned long long faults;
+    unsigned long long evictions;
+    unsigned long long scanned;    /* 回收时检查的页数 */
+    unsigned long long promoted;   /* 回收时因引用位被提升的页数 */
+    unsigned long long aged;       /* 新建的代数 */
+} WSClockMglru;
+
+/*
+ * 初始化
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或内存不足
+ */
+int wsclock_mglru_init(WSClockMglru* mglru, int page_count, int capacity);
+
+/*
+ * 访问一页
+ * 参数:
+ *   - victim_page: 可为NULL；发生回收时写入被回收的页号，否则写入-1
+ * 返回值: WSCLOCK_ACCESS_HIT / FAULT / FAULT|EVICT，页号非法时为 WSCLOCK_ACCESS_INVALID
+ */
+int wsclock_mglru_access(WSClockMglru* mglru, int page, int* victim_page);
+
+/*
+ * 老化：新建一代，已有的代数达到上限时不做任何事
+ */
+void wsclock_mglru_age(WSClockMglru* mglru);
+
+/*
+ * 页面是否驻留
+ */
+int wsclock_mglru_resident(const WSClockMglru* mglru, int page);
+
+void wsclock_mglru_free(WSClockMglru* mglru);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_MGLRU_H */
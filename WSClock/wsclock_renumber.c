@@ -0,0 +1,103 @@
+#include <stdlib.h>
+#include <string.h>
+#include "wsclock_renumber.h"
+
+int wsclock_renumber_build(WSClockRenumber* renumber, const int* sequence, int length,
+                           int profile_length, int page_count, int mode)
+{
+    if (!renumber || (!sequence && length > 0) || length < 0 || page_count <= 0) return -1;
+    if (mode != WSCLOCK_RENUMBER_FIRST_TOUCH && mode != WSCLOCK_RENUMBER_FREQUENCY) return -1;
+    memset(renumber, 0, sizeof(WSClockRenumber));
+    if (profile_length <= 0 || profile_length > length) profile_length = length;
+
+    size_t n = (size_t)page_count;
+    renumber->to_new = (int*)malloc(sizeof(int) * n);
+    renumber->to_old = (int*)malloc(sizeof(int) * n);
+    int* first = (int*)malloc(sizeof(int) * n);    /* 第一次访问的位置，未访问为 -1 */
+    int* count = (int*)calloc(n, sizeof(int));
+    if (!renumber->to_new || !renumber->to_old || !first || !count) {
+        free(first);
+        free(count);
+        wsclock_renumber_free(renumber);
+        return -1;
+    }
+    renumber->page_count = page_count;
+    renumber->mode = mode;
+    renumber->profiled_refs = profile_length;
+
+    /* 剖析：按第一次访问的顺序把页号记到 to_old 的前 touched 项 */
+    memset(first, 0xff, sizeof(int) * n);
+    int touched = 0;
+    for (int i = 0; i < profile_length; i++) {
+        int page = sequence[i];
+        if (page < 0 || page >= page_count) continue;
+        if (first[page] < 0) {
+            first[page] = i;
+            renumber->to_old[touched++] = page;
+        }
+        count[page]++;
+    }
+    renumber->touched = touched;
+
+    if (mode == WSCLOCK_RENUMBER_FREQUENCY && touched > 1) {
+        /* 按访问次数做计数排序(稳定，次数相同的保持第一次访问的先后) */
+        int max = 0;
+        for (int k = 0; k < touched; k++) {
+            if (count[renumber->to_old[k]] > max) max = count[renumber->to_old[k]];
+        }
+        int* bucket = (int*)calloc((size_t)max + 2, sizeof(int));
+        int* sorted = (int*)malloc(sizeof(int) * (size_t)touched);
+        if (!bucket || !sorted) {
+            free(bucket);
+            free(sorted);
+            free(first);
+            free(count);
+            wsclock_renumber_free(renumber);
+            return -1;
+        }
+        /* bucket[c] 为次数大于 c 的页数，即次数为 c 的页在结果中的起点 */
+        for (int k = 0; k < touched; k++) bucket[count[renumber->to_old[k]]]++;
+        int at = 0;
+        for (int c = max; c >= 0; c--) {
+            int here = bucket[c];
+            bucket[c] = at;
+            at += here;
+        }
+        for (int k = 0; k < touched; k++) {
+            int page = renumber->to_old[k];
+            sorted[bucket[count[page]]++] = page;
+        }
+        memcpy(renumber->to_old, sorted, sizeof(int) * (size_t)touched);
+        free(bucket);
+        free(sorted);
+    }
+
+    /* 没有出现过的页号按原顺序接在后面 */
+    int next = touched;
+    for (int page = 0; page < page_count; page++) {
+        if (first[page] < 0) renumber->to_old[next++] = page;
+    }
+    for (int k = 0; k < page_count; k++) {
+        renumber->to_new[renumber->to_old[k]] = k;
+    }
+    free(first);
+    free(count);
+    return 0;
+}
+
+void wsclock_renumber_apply(const WSClockRenumber* renumber, int* sequence, int length)
+{
+    if (!renumber || !renumber->to_new || !sequence) return;
+    for (int i = 0; i < length; i++) {
+        int page = sequence[i];
+        if (page >= 0 && page < renumber->page_count) sequence[i] = renumber->to_new[page];
+    }
+}
+
+void wsclock_renumber_free(WSClockRenumber* renumber)
+{
+    if (!renumber) return;
+    free(renumber->to_new);
+    free(renumber->to_old);
+    memset(renumber, 0, sizeof(WSClockRenumber));
+}
@@ -0,0 +1,68 @@
+#ifndef WSCLOCK_RENUMBER_H
+#define WSCLOCK_RENUMBER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 重排方式
+ *  - FIRST_TOUCH: 按第一次被访问的先后编号
+ *  - FREQUENCY: 按访问次数从多到少编号(次数相同时先被访问的在前)
+ */
+#define WSCLOCK_RENUMBER_FIRST_TOUCH 0
+#define WSCLOCK_RENUMBER_FREQUENCY   1
+
+/*
+ * 页号重排：对 [0, page_count) 内的页号做一一映射，让热点页集中在页表开头的少数缓存行里。
+ * 所有进程共用同一个映射(模拟器中各进程的页号空间相同，并发模式下一份序列会被所有线程访问)，
+ * 越界的页号保持不变(仍然是无效访问)
+ *  - to_new[old] 为新页号，to_old[new] 为原页号，输出时用 to_old 换回原页号
+ *  - 剖析阶段没有出现的页号按原顺序排在最后
+ */
+typedef struct WSClockRenumber {
+    int page_count;
+    int mode;
+    int* to_new;
+    int* to_old;
+    int profiled_refs;   /* 实际剖析的引用数 */
+    int touched;         /* 剖析阶段出现过的不同页数 */
+} WSClockRenumber;
+
+/*
+ * 剖析序列的前 profile_length 条引用(<=0 或超过 length 时剖析整个序列)，生成映射
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或内存不足
+ */
+int wsclock_renumber_build(WSClockRenumber* renumber, const int* sequence, int length,
+                           int profile_length, int page_count, int mode);
+
+/*
+ * 把序列中的页号原地换成新页号
+ */
+void wsclock_renumber_apply(const WSClockRenumber* renumber, int* sequence, int length);
+
+/*
+ * 新页号 -> 原页号(越界的页号原样返回)
+ */
+static inline int wsclock_renumber_original(const WSClockRenumber* renumber, int page)
+{
+    return (renumber && page >= 0 && page < renumber->page_count) ? renumber->to_old[page] : page;
+}
+
+/*
+ * 原页号 -> 新页号(越界的页号原样返回)
+ */
+static inline int wsclock_renumber_mapped(const WSClockRenumber* renumber, int page)
+{
+    return (renumber && page >= 0 && page < renumber->page_count) ? renumber->to_new[page] : page;
+}
+
+void wsclock_renumber_free(WSClockRenumber* renumber);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_RENUMBER_H */
@@ -0,0 +1,65 @@
+#include <string.h>
+#include "wsclock_scanner.h"
+#include "wsclock_atomic.h"
+#include "wsclock_time.h"
+
+/*
+ * 扫描线程主体：每次唤醒对所有进程各扫描一次预算，然后休眠
+ */
+static void* scanner_thread_main(void* arg)
+{
+    WSClockScanner* scanner = (WSClockScanner*)arg;
+    WSClockEnvironment* env = scanner->env;
+
+    while (WS_ATOMIC_LOAD(&scanner->running)) {
+        for (int i = 0; i < env->process_count; i++) {
+            Process* proc = &env->processes[i];
+            int budget = scanner->budget;
+            if (budget <= 0) {
+                budget = wsclock_scan_budget_for_period(proc->page_count, 8);
+            }
+
+            WSClockScanStats stats;
+            if (wsclock_periodic_scan_budget(env, i, budget, &stats) < 0) {
+                continue;
+            }
+            scanner->calls++;
+            scanner->pages_scanned += (unsigned long long)stats.pages_scanned;
+            scanner->bits_cleared += (unsigned long long)stats.bits_cleared;
+            scanner->total_ns += stats.elapsed_ns;
+            if (stats.elapsed_ns > scanner->max_ns) {
+                scanner->max_ns = stats.elapsed_ns;
+            }
+        }
+        wsclock_sleep_us(scanner->interval_us);
+    }
+    return 0;
+}
+
+int wsclock_scanner_start(WSClockScanner* scanner,
+                          WSClockEnvironment* env,
+                          int budget,
+                          unsigned int interval_us)
+{
+    if (!scanner || !env) return -1;
+
+    memset(scanner, 0, sizeof(WSClockScanner));
+    scanner->env = env;
+    scanner->budget = budget;
+    scanner->interval_us = interval_us;
+    WS_ATOMIC_STORE(&scanner->running, 1);
+
+    if (pthread_create(&scanner->thread, 0, scanner_thread_main, scanner) != 0) {
+        WS_ATOMIC_STORE(&scanner->running, 0);
+        return -1;
+    }
+    return 0;
+}
+
+void wsclock_scanner_stop(WSClockScanner* scanner)
+{
+    if (!scanner || !WS_ATOMIC_LOAD(&scanner->running)) return;
+
+    WS_ATOMIC_STORE(&scanner->running, 0);
+    pthread_join(scanner->thread, 0);
+}
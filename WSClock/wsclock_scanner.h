@@ -0,0 +1,54 @@
+#ifndef WSCLOCK_SCANNER_H
+#define WSCLOCK_SCANNER_H
+
+#include <pthread.h>
+#include "wsclock_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 后台扫描线程：周期性唤醒，对每个进程调用一次 wsclock_periodic_scan_budget，
+ * 把清理引用位的工作均匀摊到时间轴上，而不是在调度循环里一次性扫完全部页表。
+ * 扫描线程只清零引用位(原子操作)，可与访问页面的线程并发运行。
+ */
+typedef struct WSClockScanner {
+    WSClockEnvironment* env;
+    int budget;                 /* 每次唤醒时每个进程最多扫描的页表项数 */
+    unsigned int interval_us;   /* 两次唤醒之间的间隔(微秒) */
+    int running;                /* 运行标志(原子读写) */
+    pthread_t thread;
+
+    /* 统计信息：仅由扫描线程写入，停止后读取 */
+    unsigned long calls;                /* wsclock_periodic_scan_budget 调用次数 */
+    unsigned long long pages_scanned;   /* 累计扫描的页表项数 */
+    unsigned long long bits_cleared;    /* 累计清零的引用位数 */
+    unsigned long long total_ns;        /* 累计扫描耗时 */
+    unsigned long long max_ns;          /* 单次调用的最大耗时 */
+} WSClockScanner;
+
+/*
+ * 启动后台扫描线程
+ * 参数:
+ *   - budget: 每次唤醒每个进程的扫描预算，<=0 时按每进程页数的1/8计算
+ *   - interval_us: 唤醒间隔(微秒)
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或线程创建失败
+ */
+int wsclock_scanner_start(WSClockScanner* scanner,
+                          WSClockEnvironment* env,
+                          int budget,
+                          unsigned int interval_us);
+
+/*
+ * 停止后台扫描线程并等待其退出
+ */
+void wsclock_scanner_stop(WSClockScanner* scanner);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_SCANNER_H */
@@ -0,0 +1,305 @@
+#include <stdlib.h>
+#include <string.h>
+#include "wsclock_sched.h"
+#include "wsclock_coro.h"
+
+/* 进程在调度器中的状态 */
+#define SCHED_WAITING_ADMIT 0   /* 尚未被负载控制装入 */
+#define SCHED_READY         1
+#define SCHED_BLOCKED       2   /* 等待缺页I/O完成 */
+#define SCHED_DONE          3
+
+/* 模拟进程：协程状态 + 执行位置，挂起点之间需保留的变量都放在这里 */
+typedef struct SchedProc {
+    WSCoroutine co;
+    const int* stream;
+    int length;
+    int round;
+    int pos;
+    int slice;                       /* 本次调度已执行的访问数 */
+    int state;
+    unsigned long long blocked_since;
+    unsigned long long ready_since;
+    WSClockSchedProcessStats st;
+} SchedProc;
+
+/* I/O 完成事件 */
+typedef struct SchedEvent {
+    unsigned long long time;
+    int pid;
+} SchedEvent;
+
+typedef struct Scheduler {
+    WSClockEnvironment* env;
+    const WSClockSchedConfig* config;
+    int rounds;
+    int n;
+    SchedProc* procs;
+    unsigned long long now;          /* 全局模拟时间 */
+
+    int* ready;                      /* 就绪队列(环形FIFO) */
+    int ready_head;
+    int ready_count;
+
+    SchedEvent* events;              /* I/O 完成事件的小顶堆，每个阻塞进程至多一个事件 */
+    int event_count;
+
+    unsigned long long* slot_free;   /* 设备各槽位的空闲时刻 */
+    int queue_depth;
+
+    unsigned long long cpu_busy_ns;
+    unsigned long long device_busy_ns;
+    int active_count;
+    int frames_used;
+    int next_admit;
+    int max_concurrent;
+} Scheduler;
+
+static void ready_push(Scheduler* s, int pid)
+{
+    s->ready[(s->ready_head + s->ready_count) % s->n] = pid;
+    s->ready_count++;
+    s->procs[pid].state = SCHED_READY;
+    s->procs[pid].ready_since = s->now;
+}
+
+static int ready_pop(Scheduler* s)
+{
+    int pid = s->ready[s->ready_head];
+    s->ready_head = (s->ready_head + 1) % s->n;
+    s->ready_count--;
+    return pid;
+}
+
+static void event_push(Scheduler* s, unsigned long long time, int pid)
+{
+    int i = s->event_count++;
+    s->events[i].time = time;
+    s->events[i].pid = pid;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (s->events[parent].time <= s->events[i].time) break;
+        SchedEvent tmp = s->events[parent];
+        s->events[parent] = s->events[i];
+        s->events[i] = tmp;
+        i = parent;
+    }
+}
+
+static SchedEvent event_pop(Scheduler* s)
+{
+    SchedEvent top = s->events[0];
+    s->events[0] = s->events[--s->event_count];
+    int i = 0;
+    for (;;) {
+        int smallest = i;
+        int l = 2 * i + 1;
+        int r = l + 1;
+        if (l < s->event_count && s->events[l].time < s->events[smallest].time) smallest = l;
+        if (r < s->event_count && s->events[r].time < s->events[smallest].time) smallest = r;
+        if (smallest == i) break;
+        SchedEvent tmp = s->events[smallest];
+        s->events[smallest] = s->events[i];
+        s->events[i] = tmp;
+        i = smallest;
+    }
+    return top;
+}
+
+/*
+ * 向设备提交缺页请求：占用最早空闲的槽位，完成时刻放入事件队列
+ */
+static void sched_submit_io(Scheduler* s, int pid, int access_flags)
+{
+    unsigned long long service = (access_flags & WSCLOCK_ACCESS_MINOR) ? 0 : s->config->timing.fault_ns;
+    if (access_flags & WSCLOCK_ACCESS_WRITEBACK) {
+        service += s->config->timing.writeback_ns;
+    }
+    int slot = 0;
+    for (int i = 1; i < s->queue_depth; i++) {
+        if (s->slot_free[i] < s->slot_free[slot]) slot = i;
+    }
+    unsigned long long start = s->slot_free[slot] > s->now ? s->slot_free[slot] : s->now;
+    unsigned long long finish = start + service;
+    s->slot_free[slot] = finish;
+    s->device_busy_ns += service;
+
+    s->procs[pid].state = SCHED_BLOCKED;
+    s->procs[pid].blocked_since = s->now;
+    event_push(s, finish, pid);
+}
+
+/*
+ * 负载控制：按进程编号顺序装入，直到达到进程数上限或页框不足
+ * 没有任何进程装入时至少装入一个，避免工作集大于内存时饿死
+ */
+static void sched_admit(Scheduler* s)
+{
+    while (s->next_admit < s->n) {
+        int pid = s->next_admit;
+        int ws = s->env->processes[pid].working_set_size;
+        if (s->config->max_active > 0 && s->active_count >= s->config->max_active) break;
+        if (s->config->memory_frames > 0 && s->active_count > 0 &&
+            s->frames_used + ws > s->config->memory_frames) break;
+
+        s->env->processes[pid].active = 1;
+        s->frames_used += ws;
+        s->active_count++;
+        s->next_admit++;
+        s->procs[pid].st.admit_ns = s->now;
+        ready_push(s, pid);
+        if (s->active_count > s->max_concurrent) {
+            s->max_concurrent = s->active_count;
+        }
+    }
+}
+
+/*
+ * 进程协程体：执行引用序列，缺页时提交I/O并挂起等待完成，时间片用完则让出CPU
+ */
+static int sched_process_body(Scheduler* s, int pid)
+{
+    SchedProc* p = &s->procs[pid];
+
+    WS_CO_BEGIN(p->co);
+    for (p->round = 0; p->round < s->rounds; p->round++) {
+        for (p->pos = 0; p->pos < p->length; p->pos++) {
+            {
+                int result = wsclock_access_page_ex(s->env, pid, p->stream[p->pos], 0, 0);
+                if (result == WSCLOCK_ACCESS_INVALID) continue;
+
+                s->now += s->config->timing.hit_ns;
+                s->cpu_busy_ns += s->config->timing.hit_ns;
+                p->st.refs++;
+                p->slice++;
+
+                if ((result & WSCLOCK_ACCESS_FAULT) &&
+                    (!(result & WSCLOCK_ACCESS_MINOR) || (result & WSCLOCK_ACCESS_WRITEBACK))) {
+                    if (!(result & WSCLOCK_ACCESS_MINOR)) p->st.faults++;
+                    sched_submit_io(s, pid, result);
+                } else if (p->slice < s->config->quantum) {
+                    continue;
+                }
+            }
+            if (p->state == SCHED_BLOCKED) {
+                WS_CO_AWAIT(p->co);            /* 等待缺页完成 */
+            } else {
+                WS_CO_YIELD(p->co, WS_CO_READY); /* 时间片用完 */
+            }
+        }
+    }
+    WS_CO_END(p->co);
+}
+
+static void sched_free(Scheduler* s)
+{
+    free(s->procs);
+    free(s->ready);
+    free(s->events);
+    free(s->slot_free);
+}
+
+int wsclock_sched_run(WSClockEnvironment* env,
+                      const int* const* streams,
+                      const int* lengths,
+                      int rounds,
+                      const WSClockSchedConfig* config,
+                      WSClockSchedStats* stats,
+                      WSClockSchedProcessStats* per_process)
+{
+    if (!env || !streams || !lengths || !config || env->process_count <= 0 || rounds <= 0) {
+        return -1;
+    }
+
+    Scheduler s;
+    memset(&s, 0, sizeof(Scheduler));
+    s.env = env;
+    s.config = config;
+    s.rounds = rounds;
+    s.n = env->process_count;
+    s.queue_depth = config->timing.queue_depth > 0 ? config->timing.queue_depth : 1;
+    s.procs = (SchedProc*)calloc((size_t)s.n, sizeof(SchedProc));
+    s.ready = (int*)calloc((size_t)s.n, sizeof(int));
+    s.events = (SchedEvent*)calloc((size_t)s.n, sizeof(SchedEvent));
+    s.slot_free = (unsigned long long*)calloc((size_t)s.queue_depth, sizeof(unsigned long long));
+    if (!s.procs || !s.ready || !s.events || !s.slot_free) {
+        sched_free(&s);
+        return -1;
+    }
+
+    WSClockSchedConfig cfg = *config;
+    if (cfg.quantum <= 0) cfg.quantum = 1;
+    s.config = &cfg;
+
+    for (int i = 0; i < s.n; i++) {
+        WS_CO_INIT(s.procs[i].co);
+        s.procs[i].stream = streams[i];
+        s.procs[i].length = streams[i] ? lengths[i] : 0;
+        s.procs[i].state = SCHED_WAITING_ADMIT;
+        env->processes[i].active = 0;
+    }
+
+    sched_admit(&s);
+
+    int finished = 0;
+    while (finished < s.n) {
+        /* 已完成的I/O：对应进程回到就绪队列 */
+        while (s.event_count > 0 && s.events[0].time <= s.now) {
+            SchedEvent ev = event_pop(&s);
+            SchedProc* p = &s.procs[ev.pid];
+            p->st.stall_ns += ev.time - p->blocked_since;
+            ready_push(&s, ev.pid);
+            p->ready_since = ev.time;
+        }
+
+        if (s.ready_count == 0) {
+            if (s.event_count == 0) break;
+            s.now = s.events[0].time; /* CPU 空闲，快进到下一个I/O完成 */
+            continue;
+        }
+
+        int pid = ready_pop(&s);
+        SchedProc* p = &s.procs[pid];
+        p->st.ready_ns += s.now - p->ready_since;
+        p->slice = 0;
+
+        int status = sched_process_body(&s, pid);
+        if (status == WS_CO_READY) {
+            ready_push(&s, pid);
+        } else if (status == WS_CO_DONE) {
+            p->state = SCHED_DONE;
+            p->st.finish_ns = s.now;
+            finished++;
+            s.active_count--;
+            s.frames_used -= env->processes[pid].working_set_size;
+            env->processes[pid].active = 0;
+            sched_admit(&s);
+        }
+        /* WS_CO_WAIT: 已在 sched_submit_io 中登记完成事件 */
+    }
+
+    if (stats) {
+        memset(stats, 0, sizeof(WSClockSchedStats));
+        for (int i = 0; i < s.n; i++) {
+            stats->refs += s.procs[i].st.refs;
+            stats->faults += s.procs[i].st.faults;
+        }
+        stats->makespan_ns = s.now;
+        stats->cpu_busy_ns = s.cpu_busy_ns;
+        stats->device_busy_ns = s.device_busy_ns;
+        stats->max_concurrent = s.max_concurrent;
+        if (s.now > 0) {
+            stats->throughput = (double)stats->refs * 1e9 / (double)s.now;
+            stats->cpu_utilization = (double)s.cpu_busy_ns / (double)s.now;
+            stats->device_utilization = (double)s.device_busy_ns / ((double)s.now * (double)s.queue_depth);
+        }
+    }
+    if (per_process) {
+        for (int i = 0; i < s.n; i++) {
+            per_process[i] = s.procs[i].st;
+        }
+    }
+
+    sched_free(&s);
+    return 0;
+}
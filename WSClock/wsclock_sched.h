@@ -0,0 +1,75 @@
+#ifndef WSCLOCK_SCHED_H
+#define WSCLOCK_SCHED_H
+
+#include "wsclock_kernel.h"
+#include "wsclock_timing.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 事件驱动调度器的配置
+ *  - 每个模拟进程是一个协程：逐条执行自己的引用序列，缺页时向设备提交请求并挂起，
+ *    设备完成后重新进入就绪队列；CPU 在此期间运行其他就绪进程(CPU/I/O 重叠)
+ *  - 负载控制：同时装入的进程数不超过 max_active，且装入进程的工作集容量之和
+ *    不超过 memory_frames(工作集原则：工作集放不下就不装入)
+ */
+typedef struct WSClockSchedConfig {
+    WSClockTimingConfig timing;  /* hit_ns 作为每次访问占用的CPU时间；设备参数同时延模型 */
+    int quantum;                 /* 每次调度最多连续执行的访问数 */
+    int max_active;              /* 同时装入的进程上限，<=0 表示不限 */
+    int memory_frames;           /* 物理页框总数，<=0 表示不限 */
+} WSClockSchedConfig;
+
+/*
+ * 每个进程的调度结果
+ */
+typedef struct WSClockSchedProcessStats {
+    unsigned long long refs;
+    unsigned long long faults;
+    unsigned long long stall_ns;     /* 等待缺页完成的时间(含设备排队) */
+    unsigned long long ready_ns;     /* 在就绪队列中等待CPU的时间 */
+    unsigned long long admit_ns;     /* 被负载控制装入的时刻 */
+    unsigned long long finish_ns;    /* 完成时刻 */
+} WSClockSchedProcessStats;
+
+/*
+ * 整体调度结果
+ */
+typedef struct WSClockSchedStats {
+    unsigned long long refs;
+    unsigned long long faults;
+    unsigned long long makespan_ns;
+    unsigned long long cpu_busy_ns;
+    unsigned long long device_busy_ns;
+    int max_concurrent;              /* 同时装入的最大进程数 */
+    double throughput;               /* 每秒完成的访问数(模拟时间) */
+    double cpu_utilization;
+    double device_utilization;
+} WSClockSchedStats;
+
+/*
+ * 运行事件驱动调度
+ * 参数:
+ *   - streams/lengths: 每个进程自己的引用序列(下标与 env->processes 对应)
+ *   - rounds: 每个进程重复执行其序列的遍数
+ *   - per_process: 可为NULL；非NULL时需有 env->process_count 个元素
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或内存不足
+ * 运行期间会改写各进程的 active 标志(未装入的进程不活跃)
+ */
+int wsclock_sched_run(WSClockEnvironment* env,
+                      const int* const* streams,
+                      const int* lengths,
+                      int rounds,
+                      const WSClockSchedConfig* config,
+                      WSClockSchedStats* stats,
+                      WSClockSchedProcessStats* per_process);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_SCHED_H */
@@ -0,0 +1,233 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include "wsclock_series.h"
+
+int wsclock_series_init(WSClockSeries* series,
+                        const WSClockEnvironment* env,
+                        unsigned long interval,
+                        unsigned long long max_refs,
+                        int flags)
+{
+    if (!series || !env || env->process_count <= 0 || interval == 0) return -1;
+
+    memset(series, 0, sizeof(WSClockSeries));
+    series->process_count = env->process_count;
+    series->interval = interval;
+    series->flags = flags;
+    for (int p = 0; p < env->process_count; p++) {
+        if (env->processes[p].page_count > series->page_count) {
+            series->page_count = env->processes[p].page_count;
+        }
+    }
+    series->words = (series->page_count + 63) / 64;
+
+    /* 初始样本 + 每 interval 次一个 + 结束时补记的一个 */
+    unsigned long long samples = max_refs / interval + 2;
+    if (samples > (unsigned long long)(INT32_MAX / env->process_count)) return -1;
+    series->sample_capacity = (int)samples;
+
+    size_t procs = (size_t)env->process_count;
+    size_t rows = (size_t)series->sample_capacity * procs;
+    series->ws_size = (int*)calloc(procs, sizeof(int));
+    series->interval_refs = (unsigned long*)calloc(procs, sizeof(unsigned long));
+    series->interval_faults = (unsigned long*)calloc(procs, sizeof(unsigned long));
+    series->sample_vtime = (unsigned long long*)malloc(sizeof(unsigned long long) * (size_t)series->sample_capacity);
+    series->sample_ws = (int*)malloc(sizeof(int) * rows);
+    series->sample_fault_rate = (float*)malloc(sizeof(float) * rows);
+    int ok = series->ws_size && series->interval_refs && series->interval_faults &&
+             series->sample_vtime && series->sample_ws && series->sample_fault_rate;
+
+    if (ok && (flags & WSCLOCK_SERIES_RESIDENT)) {
+        size_t words = (size_t)series->words;
+        series->live = (unsigned long long*)calloc(procs * words, sizeof(unsigned long long));
+        series->sample_resident = (unsigned long long*)malloc(sizeof(unsigned long long) * rows * words);
+        ok = series->live && series->sample_resident;
+    }
+    if (ok && (flags & WSCLOCK_SERIES_EVENTS)) {
+        /* 每次访问至多换入一页、换出一页 */
+        series->event_capacity = (long)(max_refs * 2 < (unsigned long long)LONG_MAX ? max_refs * 2 : LONG_MAX);
+        size_t cap = (size_t)series->event_capacity;
+        series->ev_vtime = (unsigned long long*)malloc(sizeof(unsigned long long) * (cap ? cap : 1));
+        series->ev_process = (int*)malloc(sizeof(int) * (cap ? cap : 1));
+        series->ev_page = (int*)malloc(sizeof(int) * (cap ? cap : 1));
+        ok = series->ev_vtime && series->ev_process && series->ev_page;
+    }
+    if (!ok) {
+        wsclock_series_free(series);
+        return -1;
+    }
+
+    /* 以当前工作集为初始状态 */
+    for (int p = 0; p < env->process_count; p++) {
+        const Process* proc = &env->processes[p];
+        for (int j = 0; proc->page_dir && j < proc->page_count; j++) {
+            if (!wsclock_page(proc, j)->in_working_set) continue;
+            series->ws_size[p]++;
+            if (series->live) {
+                series->live[(size_t)p * (size_t)series->words + (size_t)(j / 64)] |= 1ULL << (j % 64);
+            }
+        }
+    }
+    wsclock_series_finish(series);
+    return 0;
+}
+
+static void series_sample(WSClockSeries* s)
+{
+    if (s->sample_count >= s->sample_capacity) {
+        s->dropped_samples++;
+        return;
+    }
+    int t = s->sample_count++;
+    size_t row = (size_t)t * (size_t)s->process_count;
+    s->sample_vtime[t] = s->vtime;
+    for (int p = 0; p < s->process_count; p++) {
+        s->sample_ws[row + (size_t)p] = s->ws_size[p];
+        s->sample_fault_rate[row + (size_t)p] = s->interval_refs[p]
+            ? (float)s->interval_faults[p] / (float)s->interval_refs[p] : 0.0f;
+        s->interval_refs[p] = 0;
+        s->interval_faults[p] = 0;
+    }
+    if (s->sample_resident) {
+        size_t words = (size_t)s->words;
+        memcpy(&s->sample_resident[row * words], s->live,
+               sizeof(unsigned long long) * (size_t)s->process_count * words);
+    }
+}
+
+static void series_event(WSClockSeries* s, int process_index, int code)
+{
+    if (s->event_count >= s->event_capacity) {
+        s->dropped_events++;
+        return;
+    }
+    s->ev_vtime[s->event_count] = s->vtime;
+    s->ev_process[s->event_count] = process_index;
+    s->ev_page[s->event_count] = code;
+    s->event_count++;
+}
+
+void wsclock_series_record(WSClockSeries* series, int process_index, int page, int result, int victim_page)
+{
+    if (!series || process_index < 0 || process_index >= series->process_count) return;
+    if (result == WSCLOCK_ACCESS_INVALID) return;
+
+    WSClockSeries* s = series;
+    s->vtime++;
+    s->interval_refs[process_index]++;
+    if (result & WSCLOCK_ACCESS_FAULT) {
+        unsigned long long* live = s->live ? &s->live[(size_t)process_index * (size_t)s->words] : NULL;
+        s->interval_faults[process_index]++;
+        if (victim_page >= 0 && (result & WSCLOCK_ACCESS_EVICT)) {
+            s->ws_size[process_index]--;
+            if (live) live[victim_page / 64] &= ~(1ULL << (victim_page % 64));
+            if (s->ev_page) series_event(s, process_index, ~victim_page);
+        }
+        s->ws_size[process_index]++;
+        if (live) live[page / 64] |= 1ULL << (page % 64);
+        if (s->ev_page) series_event(s, process_index, page);
+    }
+    if (s->vtime % s->interval == 0) {
+        series_sample(s);
+    }
+}
+
+void wsclock_series_finish(WSClockSeries* series)
+{
+    if (!series) return;
+    if (series->sample_count > 0 && series->sample_vtime[series->sample_count - 1] == series->vtime) return;
+    series_sample(series);
+}
+
+void wsclock_series_write_csv(FILE* fp, const WSClockSeries* series)
+{
+    if (!fp || !series) return;
+    int resident = series->sample_resident != NULL;
+    fprintf(fp, "vtime,process,ws_size,fault_rate%s\n", resident ? ",resident" : "");
+    for (int t = 0; t < series->sample_count; t++) {
+        size_t row = (size_t)t * (size_t)series->process_count;
+        for (int p = 0; p < series->process_count; p++) {
+            fprintf(fp, "%llu,%d,%d,%.6f", series->sample_vtime[t], p,
+                    series->sample_ws[row + (size_t)p], (double)series->sample_fault_rate[row + (size_t)p]);
+            if (resident) {
+                const unsigned long long* bits = &series->sample_resident[(row + (size_t)p) * (size_t)series->words];
+                const char* sep = "";
+                fputc(',', fp);
+                for (int j = 0; j < series->page_count; j++) {
+                    if (bits[j / 64] & (1ULL << (j % 64))) {
+                        fprintf(fp, "%s%d", sep, j);
+                        sep = " ";
+                    }
+                }
+            }
+            fputc('\n', fp);
+        }
+    }
+}
+
+void wsclock_series_write_events_csv(FILE* fp, const WSClockSeries* series)
+{
+    if (!fp || !series) return;
+    fprintf(fp, "vtime,process,page,event\n");
+    for (long i = 0; i < series->event_count; i++) {
+        int code = series->ev_page[i];
+        fprintf(fp, "%llu,%d,%d,%s\n", series->ev_vtime[i], series->ev_process[i],
+                code >= 0 ? code : ~code, code >= 0 ? "in" : "out");
+    }
+}
+
+int wsclock_series_write_binary(FILE* fp, const WSClockSeries* series)
+{
+    if (!fp || !series) return -1;
+
+    uint32_t head32[6];
+    uint64_t head64[3];
+    head32[0] = WSCLOCK_SERIES_MAGIC;
+    head32[1] = WSCLOCK_SERIES_VERSION;
+    head32[2] = (uint32_t)series->process_count;
+    head32[3] = (uint32_t)series->page_count;
+    head32[4] = (uint32_t)series->words;
+    head32[5] = (uint32_t)((series->sample_resident ? WSCLOCK_SERIES_RESIDENT : 0) |
+                           (series->ev_page ? WSCLOCK_SERIES_EVENTS : 0));
+    head64[0] = series->interval;
+    head64[1] = (uint64_t)series->sample_count;
+    head64[2] = (uint64_t)series->event_count;
+
+    size_t samples = (size_t)series->sample_count;
+    size_t rows = samples * (size_t)series->process_count;
+    size_t events = (size_t)series->event_count;
+    int ok = fwrite(head32, sizeof(head32), 1, fp) == 1 &&
+             fwrite(head64, sizeof(head64), 1, fp) == 1 &&
+             fwrite(series->sample_vtime, sizeof(unsigned long long), samples, fp) == samples &&
+             fwrite(series->sample_ws, sizeof(int), rows, fp) == rows &&
+             fwrite(series->sample_fault_rate, sizeof(float), rows, fp) == rows;
+    if (ok && series->sample_resident) {
+        size_t words = rows * (size_t)series->words;
+        ok = fwrite(series->sample_resident, sizeof(unsigned long long), words, fp) == words;
+    }
+    if (ok && series->ev_page) {
+        ok = fwrite(series->ev_vtime, sizeof(unsigned long long), events, fp) == events &&
+             fwrite(series->ev_process, sizeof(int), events, fp) == events &&
+             fwrite(series->ev_page, sizeof(int), events, fp) == events;
+    }
+    return ok ? 0 : -1;
+}
+
+void wsclock_series_free(WSClockSeries* series)
+{
+    if (!series) return;
+    free(series->ws_size);
+    free(series->interval_refs);
+    free(series->interval_faults);
+    free(series->live);
+    free(series->sample_vtime);
+    free(series->sample_ws);
+    free(series->sample_fault_rate);
+    free(series->sample_resident);
+    free(series->ev_vtime);
+    free(series->ev_process);
+    free(series->ev_page);
+    memset(series, 0, sizeof(WSClockSeries));
+}
@@ -0,0 +1,109 @@
+#ifndef WSCLOCK_SERIES_H
+#define WSCLOCK_SERIES_H
+
+#include <stdio.h>
+#include "wsclock_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 记录内容
+ *  - WSCLOCK_SERIES_RESIDENT: 每个样本附带各进程的驻留页位图(完整快照)
+ *  - WSCLOCK_SERIES_EVENTS: 记录每次换入/换出事件(增量)，可由事件重建任意时刻的驻留集
+ */
+#define WSCLOCK_SERIES_RESIDENT 0x1
+#define WSCLOCK_SERIES_EVENTS   0x2
+
+/* 二进制导出格式的标识与版本 */
+#define WSCLOCK_SERIES_MAGIC    0x53545357u  /* "WSTS" */
+#define WSCLOCK_SERIES_VERSION  1
+
+/*
+ * 工作集时间序列：按虚拟时间(记录的访问次数)每 interval 次采样一次所有进程，
+ * 数据按列存放在初始化时一次分配好的缓冲区里，运行中不分配内存、不做输出
+ *  - 样本 t 的进程 p 位于各列的下标 t * process_count + p
+ *  - fault_rate 为两次采样之间该进程的缺页率(区间内没有访问时为0)
+ *  - 驻留位图每进程占 words 个64位字，页 j 为第 j/64 个字的第 j%64 位
+ *  - 事件的 ev_page >= 0 表示该页换入，< 0 表示页 ~ev_page 换出
+ *  - 缓冲区写满后新数据被丢弃并计入 dropped_*
+ */
+typedef struct WSClockSeries {
+    int process_count;
+    int page_count;                /* 各进程页数的最大值，决定位图宽度 */
+    int words;                     /* 每进程位图的64位字数 */
+    unsigned long interval;
+    int flags;
+
+    unsigned long long vtime;      /* 已记录的访问次数 */
+    int* ws_size;                  /* 各进程当前工作集大小 */
+    unsigned long* interval_refs;  /* 本区间各进程的访问/缺页次数 */
+    unsigned long* interval_faults;
+    unsigned long long* live;      /* 各进程当前驻留位图(仅 RESIDENT) */
+
+    /* 样本列 */
+    int sample_count;
+    int sample_capacity;
+    unsigned long long* sample_vtime;
+    int* sample_ws;
+    float* sample_fault_rate;
+    unsigned long long* sample_resident;
+
+    /* 事件列 */
+    long event_count;
+    long event_capacity;
+    unsigned long long* ev_vtime;
+    int* ev_process;
+    int* ev_page;
+
+    unsigned long dropped_samples;
+    unsigned long dropped_events;
+} WSClockSeries;
+
+/*
+ * 初始化并预先分配缓冲区
+ * 参数:
+ *   - interval: 采样间隔(访问次数)
+ *   - max_refs: 预计记录的访问总数，用于计算样本与事件的容量
+ *   - flags: WSCLOCK_SERIES_* 组合
+ * 各进程当前的工作集作为初始状态，并立即记录 vtime=0 的样本
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或内存不足
+ */
+int wsclock_series_init(WSClockSeries* series,
+                        const WSClockEnvironment* env,
+                        unsigned long interval,
+                        unsigned long long max_refs,
+                        int flags);
+
+/*
+ * 记录一次访问的结果(wsclock_access_page_ex 的返回值与被置换页)，到达采样点时采样
+ */
+void wsclock_series_record(WSClockSeries* series, int process_index, int page, int result, int victim_page);
+
+/*
+ * 结束记录：若最后一次采样之后还有访问，补记一个样本
+ */
+void wsclock_series_finish(WSClockSeries* series);
+
+/*
+ * 导出
+ *  - CSV 样本: vtime,process,ws_size,fault_rate[,resident]，resident 为空格分隔的驻留页号
+ *  - CSV 事件: vtime,process,page,event，event 为 in/out
+ *  - 二进制(本机字节序): 头部为 uint32 的 magic, version, process_count, page_count, words, flags
+ *    与 uint64 的 interval, sample_count, event_count；之后依次为 sample_vtime, sample_ws,
+ *    sample_fault_rate, [sample_resident], [ev_vtime, ev_process, ev_page] 各列的原始数组
+ */
+void wsclock_series_write_csv(FILE* fp, const WSClockSeries* series);
+void wsclock_series_write_events_csv(FILE* fp, const WSClockSeries* series);
+int wsclock_series_write_binary(FILE* fp, const WSClockSeries* series);
+
+void wsclock_series_free(WSClockSeries* series);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_SERIES_H */
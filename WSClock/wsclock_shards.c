@@ -0,0 +1,264 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "wsclock_shards.h"
+#include "wsclock_kernel.h"
+#include "wsclock_time.h"
+
+/* 哈希空间大小：阈值 T = R * SHARDS_MODULUS */
+#define SHARDS_MODULUS (1u << 24)
+
+/*
+ * (进程号, 页号) -> 紧凑页号 的开放寻址哈希表
+ */
+typedef struct ShardsMap {
+    unsigned long long* keys;   /* 0 表示空槽，实际键加1后存放 */
+    int* values;
+    unsigned int capacity;      /* 2的幂 */
+    unsigned int count;
+} ShardsMap;
+
+static unsigned long long shards_mix64(unsigned long long x)
+{
+    /* splitmix64 终结函数 */
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static int shards_map_init(ShardsMap* m, unsigned int capacity)
+{
+    m->capacity = capacity;
+    m->count = 0;
+    m->keys = (unsigned long long*)calloc(capacity, sizeof(unsigned long long));
+    m->values = (int*)malloc(sizeof(int) * capacity);
+    return (m->keys && m->values) ? 0 : -1;
+}
+
+static void shards_map_free(ShardsMap* m)
+{
+    free(m->keys);
+    free(m->values);
+    m->keys = 0;
+    m->values = 0;
+}
+
+/* 查找键，不存在时以 value 插入；返回键对应的值，内存不足返回-1 */
+static int shards_map_get_or_insert(ShardsMap* m, unsigned long long key, int value)
+{
+    if ((m->count + 1) * 2 > m->capacity) {
+        ShardsMap bigger;
+        if (shards_map_init(&bigger, m->capacity * 2) != 0) {
+            shards_map_free(&bigger);
+            return -1;
+        }
+        for (unsigned int i = 0; i < m->capacity; i++) {
+            if (!m->keys[i]) continue;
+            unsigned int j = (unsigned int)shards_mix64(m->keys[i]) & (bigger.capacity - 1);
+            while (bigger.keys[j]) j = (j + 1) & (bigger.capacity - 1);
+            bigger.keys[j] = m->keys[i];
+            bigger.values[j] = m->values[i];
+            bigger.count++;
+        }
+        shards_map_free(m);
+        *m = bigger;
+    }
+
+    unsigned long long stored = key + 1;
+    unsigned int i = (unsigned int)shards_mix64(stored) & (m->capacity - 1);
+    while (m->keys[i]) {
+        if (m->keys[i] == stored) return m->values[i];
+        i = (i + 1) & (m->capacity - 1);
+    }
+    m->keys[i] = stored;
+    m->values[i] = value;
+    m->count++;
+    return value;
+}
+
+/* 95% 双侧 t 分布临界值，自由度 1..10；更大自由度近似取 1.96 */
+static double shards_t95(int df)
+{
+    static const double t[] = { 0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228 };
+    if (df <= 0) return 0.0;
+    return df <= 10 ? t[df] : 1.96;
+}
+
+/*
+ * 运行一个采样副本
+ * 返回值: 0 成功，-1 内存不足
+ */
+static int shards_run_replica(const int* sequence, int length, const WSClockShardsConfig* cfg,
+                              unsigned long long salt, int scaled_ws,
+                              unsigned long long* out_refs, unsigned long long* out_faults,
+                              unsigned long long* out_pages)
+{
+    int n = cfg->process_count;
+    unsigned int threshold = (unsigned int)(cfg->rate * (double)SHARDS_MODULUS + 0.5);
+
+    /* 第一遍：筛选采样引用，分配紧凑页号 */
+    ShardsMap map;
+    int* sampled_pid = 0;
+    int* sampled_page = 0;
+    int* sampled_pos = 0;
+    int* page_counts = (int*)calloc((size_t)n, sizeof(int));
+    int rc = -1;
+    if (shards_map_init(&map, 1024) != 0 || !page_counts) goto out;
+
+    int cap = 1024;
+    int count = 0;
+    sampled_pid = (int*)malloc(sizeof(int) * (size_t)cap);
+    sampled_page = (int*)malloc(sizeof(int) * (size_t)cap);
+    sampled_pos = (int*)malloc(sizeof(int) * (size_t)cap);
+    if (!sampled_pid || !sampled_page || !sampled_pos) goto out;
+
+    for (int i = 0; i < length; i++) {
+        int pid = i % n;
+        int page = sequence[i];
+        if (page < 0 || page >= cfg->page_count) continue;
+
+        unsigned long long key = ((unsigned long long)(unsigned int)pid << 32) | (unsigned int)page;
+        unsigned long long h = shards_mix64(key ^ salt);
+        if ((unsigned int)(h & (SHARDS_MODULUS - 1)) >= threshold) continue;
+
+        int cid = shards_map_get_or_insert(&map, key, page_counts[pid]);
+        if (cid < 0) goto out;
+        if (cid == page_counts[pid]) page_counts[pid]++;
+
+        if (count >= cap) {
+            cap *= 2;
+            int* a = (int*)realloc(sampled_pid, sizeof(int) * (size_t)cap);
+            if (!a) goto out;
+            sampled_pid = a;
+            a = (int*)realloc(sampled_page, sizeof(int) * (size_t)cap);
+            if (!a) goto out;
+            sampled_page = a;
+            a = (int*)realloc(sampled_pos, sizeof(int) * (size_t)cap);
+            if (!a) goto out;
+            sampled_pos = a;
+        }
+        sampled_pid[count] = pid;
+        sampled_page[count] = cid;
+        sampled_pos[count] = i;
+        count++;
+    }
+
+    /* 第二遍：只为采样页分配页表，按缩放后的工作集容量模拟 */
+    {
+        unsigned long long total_pages = 0;
+        for (int p = 0; p < n; p++) total_pages += (unsigned long long)page_counts[p];
+
+        Process* procs = (Process*)calloc((size_t)n, sizeof(Process));
+        int pages_ok = procs != NULL;
+        for (int p = 0; pages_ok && p < n; p++) {
+            /* 没有被采样到的进程不分配页表，访问它时返回 INVALID */
+            if (page_counts[p] > 0) pages_ok = wsclock_page_table_init(&procs[p], NULL, page_counts[p]) == 0;
+        }
+        if (!pages_ok) {
+            for (int p = 0; procs && p < n; p++) wsclock_page_table_release(&procs[p], NULL);
+            free(procs);
+            goto out;
+        }
+        for (int p = 0; p < n; p++) {
+            procs[p].process_id = p;
+            procs[p].working_set_size = scaled_ws;
+            procs[p].active = 1;
+        }
+        WSClockEnvironment env;
+        memset(&env, 0, sizeof(env));
+        wsclock_init(&env, procs, n, 0);
+
+        unsigned long long faults = 0;
+        long last_period = -1;
+        for (int k = 0; k < count; k++) {
+            /* 引用位清理仍按原始序列的时间进行：两次采样引用之间跨过了扫描点就扫描一次 */
+            long period = (long)(sampled_pos[k] / cfg->scan_period);
+            if (last_period >= 0 && period != last_period) {
+                for (int p = 0; p < n; p++) {
+                    if (procs[p].page_count > 0) wsclock_periodic_scan(&env, p);
+                }
+            }
+            last_period = period;
+
+            int result = wsclock_access_page(&env, sampled_pid[k], sampled_page[k]);
+            if (result != WSCLOCK_ACCESS_INVALID && (result & WSCLOCK_ACCESS_FAULT)) {
+                faults++;
+            }
+        }
+        wsclock_cleanup(&env);
+        for (int p = 0; p < n; p++) wsclock_page_table_release(&procs[p], NULL);
+        free(procs);
+
+        *out_refs = (unsigned long long)count;
+        *out_faults = faults;
+        *out_pages = total_pages;
+        rc = 0;
+    }
+
+out:
+    shards_map_free(&map);
+    free(page_counts);
+    free(sampled_pid);
+    free(sampled_page);
+    free(sampled_pos);
+    return rc;
+}
+
+int wsclock_shards_run(const int* sequence,
+                       int length,
+                       const WSClockShardsConfig* config,
+                       WSClockShardsResult* result)
+{
+    if (!sequence || length <= 0 || !config || !result) return -1;
+    if (config->rate <= 0.0 || config->rate > 1.0 || config->process_count <= 0 ||
+        config->page_count <= 0 || config->working_set_size <= 0 || config->scan_period <= 0) {
+        return -1;
+    }
+
+    int replicas = config->replicas > 0 ? config->replicas : 1;
+    unsigned long long start_ns = wsclock_now_ns();
+
+    memset(result, 0, sizeof(WSClockShardsResult));
+    result->scaled_ws = (int)(config->working_set_size * config->rate + 0.5);
+    if (result->scaled_ws < 1) result->scaled_ws = 1;
+
+    double sum_rate = 0.0, sum_rate_sq = 0.0;
+    double sum_faults = 0.0, sum_faults_sq = 0.0;
+    double sum_refs = 0.0, sum_pages = 0.0;
+    for (int r = 0; r < replicas; r++) {
+        unsigned long long refs = 0, faults = 0, pages = 0;
+        unsigned long long salt = shards_mix64(0x5ad5ULL + (unsigned long long)r);
+        if (shards_run_replica(sequence, length, config, salt, result->scaled_ws,
+                               &refs, &faults, &pages) != 0) {
+            return -1;
+        }
+        double rate = refs ? (double)faults / (double)refs : 0.0;
+        double est = (double)faults / config->rate;
+        sum_rate += rate;
+        sum_rate_sq += rate * rate;
+        sum_faults += est;
+        sum_faults_sq += est * est;
+        sum_refs += (double)refs;
+        sum_pages += (double)pages;
+    }
+
+    result->fault_rate = sum_rate / replicas;
+    result->est_faults = sum_faults / replicas;
+    result->sampled_refs = sum_refs / replicas;
+    result->sampled_pages = sum_pages / replicas;
+    if (replicas > 1) {
+        double var_rate = (sum_rate_sq - replicas * result->fault_rate * result->fault_rate) / (replicas - 1);
+        double var_faults = (sum_faults_sq - replicas * result->est_faults * result->est_faults) / (replicas - 1);
+        double t = shards_t95(replicas - 1);
+        result->fault_rate_ci95 = t * sqrt(var_rate > 0 ? var_rate / replicas : 0.0);
+        result->est_faults_ci95 = t * sqrt(var_faults > 0 ? var_faults / replicas : 0.0);
+    } else if (result->sampled_refs > 0) {
+        /* 只有一个副本时退化为二项分布近似(按引用独立计算，会低估按页采样的方差) */
+        double p = result->fault_rate;
+        result->fault_rate_ci95 = 1.96 * sqrt(p * (1.0 - p) / result->sampled_refs);
+        result->est_faults_ci95 = result->fault_rate_ci95 * (double)length;
+    }
+    result->elapsed_ns = wsclock_now_ns() - start_ns;
+    return 0;
+}
@@ -0,0 +1,53 @@
+#ifndef WSCLOCK_SHARDS_H
+#define WSCLOCK_SHARDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 空间采样近似模拟(SHARDS 方法)：
+ *  - 对 (进程号, 页号) 做哈希，只保留哈希值低于阈值的页面，采样率为 R
+ *  - 被保留页面的所有引用都参与模拟，其余页面的引用直接丢弃
+ *  - 工作集容量按 R 缩放，缺页数估计 = 采样缺页数 / R，缺页率直接取采样序列的缺页率
+ *  - 采样页重新编号为紧凑的页号，页表只为采样页分配，内存随 R 线性下降
+ *  - 使用多个独立的哈希种子重复采样，由各副本估计值的离散程度给出误差范围
+ */
+typedef struct WSClockShardsConfig {
+    double rate;           /* 采样率 R，(0, 1] */
+    int replicas;          /* 独立哈希种子(副本)个数，>=1 */
+    int process_count;
+    int page_count;        /* 原始每进程页数，越界页号被忽略 */
+    int working_set_size;  /* 原始工作集容量，模拟时按 R 缩放 */
+    int scan_period;       /* 按原始序列位置每 scan_period 次访问清理一次引用位 */
+} WSClockShardsConfig;
+
+typedef struct WSClockShardsResult {
+    int scaled_ws;                     /* 缩放后的工作集容量 */
+    double sampled_refs;               /* 每个副本平均保留的引用数 */
+    double sampled_pages;              /* 每个副本平均分配的页表项数 */
+    double fault_rate;                 /* 缺页率估计(各副本平均) */
+    double fault_rate_ci95;            /* 缺页率 95% 置信区间半宽 */
+    double est_faults;                 /* 缺页总数估计 */
+    double est_faults_ci95;
+    unsigned long long elapsed_ns;     /* 所有副本的总耗时 */
+} WSClockShardsResult;
+
+/*
+ * 运行采样模拟
+ * 参数:
+ *   - sequence/length: 页面访问序列，按轮转方式分配给各进程(与 main.c 一致)
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或内存不足
+ */
+int wsclock_shards_run(const int* sequence,
+                       int length,
+                       const WSClockShardsConfig* config,
+                       WSClockShardsResult* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_SHARDS_H */
@@ -0,0 +1,214 @@
+#include <stdlib.h>
+#include <string.h>
+#include "wsclock_shared.h"
+
+void wsclock_shared_init(WSClockSharedTable* table)
+{
+    if (!table) return;
+    memset(table, 0, sizeof(WSClockSharedTable));
+}
+
+static const WSClockSharedSegment* find_segment(const WSClockSharedTable* table, int segment_id)
+{
+    for (int i = 0; i < table->segment_count; i++) {
+        if (table->segments[i].segment_id == segment_id) {
+            return &table->segments[i];
+        }
+    }
+    return 0;
+}
+
+int wsclock_shared_add_segment(WSClockSharedTable* table, int segment_id, int page_count)
+{
+    if (!table || page_count <= 0 || find_segment(table, segment_id)) return -1;
+
+    if (table->segment_count >= table->segment_capacity) {
+        int cap = table->segment_capacity ? table->segment_capacity * 2 : 8;
+        WSClockSharedSegment* s = (WSClockSharedSegment*)realloc(table->segments,
+                                                                 sizeof(WSClockSharedSegment) * (size_t)cap);
+        if (!s) return -1;
+        table->segments = s;
+        table->segment_capacity = cap;
+    }
+    if (table->page_count + page_count > table->page_capacity) {
+        int cap = table->page_capacity ? table->page_capacity : 64;
+        while (cap < table->page_count + page_count) cap *= 2;
+        WSClockSharedPage* p = (WSClockSharedPage*)realloc(table->pages,
+                                                           sizeof(WSClockSharedPage) * (size_t)cap);
+        if (!p) return -1;
+        table->pages = p;
+        table->page_capacity = cap;
+    }
+
+    WSClockSharedSegment* seg = &table->segments[table->segment_count++];
+    seg->segment_id = segment_id;
+    seg->first = table->page_count;
+    seg->page_count = page_count;
+    for (int i = 0; i < page_count; i++) {
+        WSClockSharedPage* sp = &table->pages[table->page_count++];
+        sp->segment_id = segment_id;
+        sp->page_index = i;
+        sp->refcount = 0;
+        sp->dirty = 0;
+    }
+    return 0;
+}
+
+/*
+ * shared_map 前面的头部：fork 出的进程共享同一张映射，按引用计数释放，
+ * 修改映射时若被共享先复制一份(与页表叶子的写时复制相同)
+ */
+typedef struct SharedMapHeader {
+    int refcount;
+    int page_count;
+    int first;                     /* 映射过共享页的页号范围 [first, end) */
+    int end;
+} SharedMapHeader;
+
+static SharedMapHeader* map_header(const int* map)
+{
+    return (SharedMapHeader*)map - 1;
+}
+
+static int* map_alloc(int page_count)
+{
+    SharedMapHeader* h = (SharedMapHeader*)malloc(sizeof(SharedMapHeader) + sizeof(int) * (size_t)page_count);
+    if (!h) return 0;
+    h->refcount = 1;
+    h->page_count = page_count;
+    h->first = page_count;
+    h->end = 0;
+    return (int*)(h + 1);
+}
+
+static void map_put(int* map)
+{
+    if (!map) return;
+    SharedMapHeader* h = map_header(map);
+    if (--h->refcount == 0) free(h);
+}
+
+int wsclock_shared_map(Process* proc,
+                       const WSClockSharedTable* table,
+                       int first_page,
+                       int segment_id,
+                       int segment_offset,
+                       int count)
+{
+    if (!proc || !table || count <= 0 || first_page < 0 || segment_offset < 0) return -1;
+    if (first_page + count > proc->page_count) return -1;
+    const WSClockSharedSegment* seg = find_segment(table, segment_id);
+    if (!seg || segment_offset + count > seg->page_count) return -1;
+
+    if (!proc->shared_map) {
+        proc->shared_map = map_alloc(proc->page_count);
+        if (!proc->shared_map) return -1;
+        for (int i = 0; i < proc->page_count; i++) {
+            proc->shared_map[i] = -1;
+        }
+    } else if (map_header(proc->shared_map)->refcount > 1) {
+        /* 与 fork 出的进程共享：先复制一份自己的映射 */
+        const SharedMapHeader* old = map_header(proc->shared_map);
+        int* copy = map_alloc(old->page_count);
+        if (!copy) return -1;
+        memcpy(map_header(copy), old, sizeof(SharedMapHeader) + sizeof(int) * (size_t)old->page_count);
+        map_header(copy)->refcount = 1;
+        map_put(proc->shared_map);
+        proc->shared_map = copy;
+    }
+    for (int i = 0; i < count; i++) {
+        proc->shared_map[first_page + i] = seg->first + segment_offset + i;
+    }
+    SharedMapHeader* h = map_header(proc->shared_map);
+    if (first_page < h->first) h->first = first_page;
+    if (first_page + count > h->end) h->end = first_page + count;
+    return 0;
+}
+
+void wsclock_shared_map_inherit(Process* child, const Process* parent)
+{
+    if (!child || !parent) return;
+    map_put(child->shared_map);
+    child->shared_map = parent->shared_map;
+    if (child->shared_map) map_header(child->shared_map)->refcount++;
+}
+
+void wsclock_shared_map_span(const Process* proc, int* first, int* end)
+{
+    const SharedMapHeader* h = (proc && proc->shared_map) ? map_header(proc->shared_map) : 0;
+    if (first) *first = h ? h->first : 0;
+    if (end) *end = h ? h->end : 0;
+}
+
+void wsclock_shared_attach(WSClockEnvironment* env, WSClockSharedTable* table)
+{
+    if (!env) return;
+    env->shared = table;
+    if (!table) return;
+
+    for (int i = 0; i < table->page_count; i++) {
+        table->pages[i].refcount = 0;
+    }
+    for (int p = 0; p < env->process_count; p++) {
+        Process* proc = &env->processes[p];
+        for (int i = 0; proc->shared_map && i < proc->page_count; i++) {
+            if (proc->shared_map[i] >= 0 && wsclock_page(proc, i)->in_working_set) {
+                table->pages[proc->shared_map[i]].refcount++;
+            }
+        }
+    }
+}
+
+void wsclock_shared_usage(const WSClockEnvironment* env, int process_index, WSClockMemUsage* usage)
+{
+    if (!usage) return;
+    memset(usage, 0, sizeof(WSClockMemUsage));
+    if (!env || process_index < 0 || process_index >= env->process_count) return;
+
+    const Process* proc = &env->processes[process_index];
+    for (int i = 0; proc->page_dir && i < proc->page_count; i++) {
+        if (!wsclock_page(proc, i)->in_working_set) continue;
+        usage->rss++;
+
+        int g = (env->shared && proc->shared_map) ? proc->shared_map[i] : -1;
+        int refs = g >= 0 ? env->shared->pages[g].refcount : 1;
+        if (refs < 1) refs = 1;
+        if (g >= 0) usage->shared++;
+        usage->pss += 1.0 / (double)refs;
+        if (refs == 1) usage->uss++;
+    }
+}
+
+int wsclock_shared_resident_frames(const WSClockEnvironment* env)
+{
+    if (!env) return 0;
+    int frames = 0;
+    for (int p = 0; p < env->process_count; p++) {
+        const Process* proc = &env->processes[p];
+        for (int i = 0; proc->page_dir && i < proc->page_count; i++) {
+            int shared = env->shared && proc->shared_map && proc->shared_map[i] >= 0;
+            if (!shared && wsclock_page(proc, i)->in_working_set) frames++;
+        }
+    }
+    if (env->shared) {
+        for (int i = 0; i < env->shared->page_count; i++) {
+            if (env->shared->pages[i].refcount > 0) frames++;
+        }
+    }
+    return frames;
+}
+
+void wsclock_shared_unmap(Process* proc)
+{
+    if (!proc) return;
+    map_put(proc->shared_map);
+    proc->shared_map = 0;
+}
+
+void wsclock_shared_free(WSClockSharedTable* table)
+{
+    if (!table) return;
+    free(table->pages);
+    free(table->segments);
+    memset(table, 0, sizeof(WSClockSharedTable));
+}
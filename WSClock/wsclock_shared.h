@@ -0,0 +1,114 @@
+#ifndef WSCLOCK_SHARED_H
+#define WSCLOCK_SHARED_H
+
+#include "wsclock_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 全局共享页：由(段号, 段内页号)唯一确定，例如共享库代码页、共享内存
+ *  - refcount: 工作集中包含该页的进程数，>0 即驻留内存
+ *  - dirty: 任一进程置换该页时若为脏页则置位，最后一个进程释放时写回
+ */
+typedef struct WSClockSharedPage {
+    int segment_id;
+    int page_index;
+    int refcount;
+    int dirty;
+} WSClockSharedPage;
+
+typedef struct WSClockSharedSegment {
+    int segment_id;
+    int first;         /* 该段第一页在 pages 中的下标 */
+    int page_count;
+} WSClockSharedSegment;
+
+/*
+ * 全局共享页表
+ */
+typedef struct WSClockSharedTable {
+    WSClockSharedPage* pages;
+    int page_count;
+    int page_capacity;
+    WSClockSharedSegment* segments;
+    int segment_count;
+    int segment_capacity;
+} WSClockSharedTable;
+
+/*
+ * 进程内存统计(单位：页)
+ *  - rss: 工作集中的页数(共享页按整页计)
+ *  - pss: 按比例分摊，共享页按 1/refcount 计
+ *  - uss: 只属于本进程的页数(私有页 + 只有本进程引用的共享页)
+ */
+typedef struct WSClockMemUsage {
+    int rss;
+    int shared;        /* rss 中的共享页数 */
+    double pss;
+    int uss;
+} WSClockMemUsage;
+
+void wsclock_shared_init(WSClockSharedTable* table);
+
+/*
+ * 添加一个共享段
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 段号已存在、页数非法或内存不足
+ */
+int wsclock_shared_add_segment(WSClockSharedTable* table, int segment_id, int page_count);
+
+/*
+ * 把进程的 [first_page, first_page+count) 映射到共享段 segment_id 的 [segment_offset, ...)
+ * 首次映射时为进程分配 shared_map(其余页为私有)；shared_map 与 fork 出的进程共享时先复制一份。
+ * 应在页面装入工作集之前映射，或者映射完成后再调用 wsclock_shared_attach 重新统计引用计数
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 范围越界、段不存在或内存不足
+ */
+int wsclock_shared_map(Process* proc,
+                       const WSClockSharedTable* table,
+                       int first_page,
+                       int segment_id,
+                       int segment_offset,
+                       int count);
+
+/*
+ * fork 时子进程继承父进程的 shared_map：与父进程共享同一张映射(引用计数加1，不复制)，
+ * 之后任一方再调用 wsclock_shared_map 时才复制；释放仍由 wsclock_shared_unmap 完成
+ */
+void wsclock_shared_map_inherit(Process* child, const Process* parent);
+
+/*
+ * 映射过共享页的页号范围 [first, end)，没有 shared_map 时为空范围
+ */
+void wsclock_shared_map_span(const Process* proc, int* first, int* end);
+
+/*
+ * 将共享页表挂到环境上(在 wsclock_init 之后调用)，并按各进程当前工作集重新计算引用计数
+ */
+void wsclock_shared_attach(WSClockEnvironment* env, WSClockSharedTable* table);
+
+/*
+ * 计算进程的 RSS/PSS/USS
+ */
+void wsclock_shared_usage(const WSClockEnvironment* env, int process_index, WSClockMemUsage* usage);
+
+/*
+ * 实际占用的物理页框数：私有驻留页 + refcount>0 的共享页(每个共享页只算一次)
+ */
+int wsclock_shared_resident_frames(const WSClockEnvironment* env);
+
+/*
+ * 释放进程对 shared_map 的引用(最后一个引用者释放时归还内存) / 释放共享页表
+ */
+void wsclock_shared_unmap(Process* proc);
+void wsclock_shared_free(WSClockSharedTable* table);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_SHARED_H */
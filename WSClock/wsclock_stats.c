@@ -0,0 +1,237 @@
+#include <stdlib.h>
+#include <string.h>
+#include "wsclock_stats.h"
+#include "wsclock_atomic.h"
+#include "wsclock_time.h"
+
+/* 分桶的下界 */
+static unsigned long long hist_bucket_low(int b)
+{
+    int sub = 1 << WSCLOCK_HIST_SUB_BITS;
+    if (b < sub) {
+        return (unsigned long long)b;
+    }
+    int e = b / sub + WSCLOCK_HIST_SUB_BITS - 1;
+    return (unsigned long long)(sub + b % sub) << (e - WSCLOCK_HIST_SUB_BITS);
+}
+
+double wsclock_hist_percentile(const WSClockHistogram* hist, double p, double ticks_per_ns)
+{
+    if (!hist || hist->count == 0 || ticks_per_ns <= 0) return 0.0;
+    if (p <= 0) return (double)hist->min / ticks_per_ns;
+    if (p >= 1) return (double)hist->max / ticks_per_ns;
+
+    unsigned long long rank = (unsigned long long)(p * (double)hist->count);
+    unsigned long long seen = 0;
+    for (int b = 0; b < WSCLOCK_HIST_BUCKETS; b++) {
+        seen += hist->buckets[b];
+        if (seen > rank) {
+            /* 取桶的中点，并限制在实际最小/最大值之间 */
+            double low = (double)hist_bucket_low(b);
+            double high = b + 1 < WSCLOCK_HIST_BUCKETS ? (double)hist_bucket_low(b + 1) : (double)hist->max;
+            double v = (low + high) / 2;
+            if (v < (double)hist->min) v = (double)hist->min;
+            if (v > (double)hist->max) v = (double)hist->max;
+            return v / ticks_per_ns;
+        }
+    }
+    return (double)hist->max / ticks_per_ns;
+}
+
+#if WSCLOCK_STATS
+
+/*
+ * 直方图分桶
+ */
+static int hist_bucket(unsigned long long v)
+{
+    if (v < (1ULL << WSCLOCK_HIST_SUB_BITS)) {
+        return (int)v;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    int e = 63 - __builtin_clzll(v);     /* 最高位，>= SUB_BITS */
+#else
+    int e = 0;
+    while ((v >> e) > 1) e++;
+#endif
+    int b = (e - WSCLOCK_HIST_SUB_BITS + 1) * (1 << WSCLOCK_HIST_SUB_BITS)
+          + (int)((v >> (e - WSCLOCK_HIST_SUB_BITS)) & ((1ULL << WSCLOCK_HIST_SUB_BITS) - 1));
+    return b < WSCLOCK_HIST_BUCKETS ? b : WSCLOCK_HIST_BUCKETS - 1;
+}
+
+/*
+ * 每个线程一个直方图块，只由所属线程写(原子读-改-写分开，不加 lock 前缀)；
+ * 第一次记录时挂到全局链表上，线程退出后块仍保留，快照时合并
+ */
+typedef struct StatsBlock {
+    WSClockHistogram ops[WSCLOCK_OP_COUNT];
+    struct StatsBlock* next;
+} StatsBlock;
+
+static StatsBlock* g_blocks = 0;
+static int g_blocks_lock = 0;
+static int g_block_count = 0;
+
+/* 计时源换算比例的标定起点 */
+static unsigned long long g_calib_ticks = 0;
+static unsigned long long g_calib_ns = 0;
+
+#if defined(_MSC_VER)
+static __declspec(thread) StatsBlock* t_block = 0;
+__declspec(thread) unsigned int wsclock_stats_sample_tick = 0;
+#else
+static __thread StatsBlock* t_block = 0;
+__thread unsigned int wsclock_stats_sample_tick = 0;
+#endif
+
+static StatsBlock* stats_block_register(void)
+{
+    StatsBlock* block = (StatsBlock*)calloc(1, sizeof(StatsBlock));
+    if (!block) return 0;
+    for (int i = 0; i < WSCLOCK_OP_COUNT; i++) {
+        block->ops[i].min = ~0ULL;
+    }
+    ws_spin_lock(&g_blocks_lock);
+    if (g_block_count == 0) {
+        g_calib_ticks = wsclock_stats_ticks();
+        g_calib_ns = wsclock_now_ns();
+    }
+    block->next = g_blocks;
+    g_blocks = block;
+    g_block_count++;
+    ws_spin_unlock(&g_blocks_lock);
+    t_block = block;
+    return block;
+}
+
+void wsclock_stats_record(int op, unsigned long long ticks)
+{
+    StatsBlock* block = t_block;
+    if (!block) {
+        block = stats_block_register();
+        if (!block) return;
+    }
+    WSClockHistogram* h = &block->ops[op];
+    WSCLOCK_STATS_ADD(h->count, 1);
+    WSCLOCK_STATS_ADD(h->sum, ticks);
+    WSCLOCK_STATS_ADD(h->buckets[hist_bucket(ticks)], 1);
+    if (ticks < WS_ATOMIC_LOAD(&h->min)) WS_ATOMIC_STORE(&h->min, ticks);
+    if (ticks > WS_ATOMIC_LOAD(&h->max)) WS_ATOMIC_STORE(&h->max, ticks);
+}
+
+/* 计时源每纳秒的滴答数 */
+static double stats_ticks_per_ns(void)
+{
+#ifdef WSCLOCK_STATS_HAVE_TSC
+    unsigned long long t0 = g_calib_ticks;
+    unsigned long long n0 = g_calib_ns;
+    if (n0 == 0) {
+        t0 = wsclock_stats_ticks();
+        n0 = wsclock_now_ns();
+    }
+    /* 标定区间太短时补足 1ms */
+    while (wsclock_now_ns() - n0 < 1000000ULL) {
+        wsclock_sleep_us(200);
+    }
+    unsigned long long dt = wsclock_stats_ticks() - t0;
+    unsigned long long dn = wsclock_now_ns() - n0;
+    return dn ? (double)dt / (double)dn : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+int wsclock_stats_snapshot(WSClockStatsSnapshot* snapshot)
+{
+    if (!snapshot) return -1;
+    memset(snapshot, 0, sizeof(WSClockStatsSnapshot));
+    for (int i = 0; i < WSCLOCK_OP_COUNT; i++) {
+        snapshot->ops[i].min = ~0ULL;
+    }
+
+    ws_spin_lock(&g_blocks_lock);
+    for (StatsBlock* b = g_blocks; b; b = b->next) {
+        int used = 0;
+        for (int i = 0; i < WSCLOCK_OP_COUNT; i++) {
+            const WSClockHistogram* src = &b->ops[i];
+            WSClockHistogram* dst = &snapshot->ops[i];
+            unsigned long long count = WS_ATOMIC_LOAD(&src->count);
+            if (count == 0) continue;
+            used = 1;
+            dst->count += count;
+            dst->sum += WS_ATOMIC_LOAD(&src->sum);
+            unsigned long long mn = WS_ATOMIC_LOAD(&src->min);
+            unsigned long long mx = WS_ATOMIC_LOAD(&src->max);
+            if (mn < dst->min) dst->min = mn;
+            if (mx > dst->max) dst->max = mx;
+            for (int k = 0; k < WSCLOCK_HIST_BUCKETS; k++) {
+                dst->buckets[k] += WS_ATOMIC_LOAD(&src->buckets[k]);
+            }
+        }
+        snapshot->threads += used;
+    }
+    ws_spin_unlock(&g_blocks_lock);
+
+    for (int i = 0; i < WSCLOCK_OP_COUNT; i++) {
+        if (snapshot->ops[i].count == 0) snapshot->ops[i].min = 0;
+    }
+    snapshot->ticks_per_ns = stats_ticks_per_ns();
+    return 0;
+}
+
+int wsclock_stats_process(const WSClockEnvironment* env, int process_index, WSClockProcCounters* counters)
+{
+    if (!env || !counters || process_index < 0 || process_index >= env->process_count) return -1;
+    const Process* proc = &env->processes[process_index];
+    const WSClockProcCounters* c = &proc->counters;
+
+    counters->faults = WS_ATOMIC_LOAD(&c->faults);
+    counters->minor_faults = WS_ATOMIC_LOAD(&c->minor_faults);
+    counters->evictions = WS_ATOMIC_LOAD(&c->evictions);
+    counters->writebacks = WS_ATOMIC_LOAD(&c->writebacks);
+    counters->victim_searches = WS_ATOMIC_LOAD(&c->victim_searches);
+    counters->victim_pages_scanned = WS_ATOMIC_LOAD(&c->victim_pages_scanned);
+    counters->scans = WS_ATOMIC_LOAD(&c->scans);
+    counters->scan_pages = WS_ATOMIC_LOAD(&c->scan_pages);
+    counters->bits_cleared = WS_ATOMIC_LOAD(&c->bits_cleared);
+    counters->clock_base = c->clock_base;
+
+    /* 每次有效访问进程时钟加1：访问次数 - 缺页次数 = 命中次数 */
+    unsigned long refs = WS_ATOMIC_LOAD(&proc->clock) - c->clock_base;
+    counters->hits = refs > counters->faults ? refs - counters->faults : 0;
+    return 0;
+}
+
+void wsclock_stats_reset(void)
+{
+    ws_spin_lock(&g_blocks_lock);
+    for (StatsBlock* b = g_blocks; b; b = b->next) {
+        memset(b->ops, 0, sizeof(b->ops));
+        for (int i = 0; i < WSCLOCK_OP_COUNT; i++) {
+            b->ops[i].min = ~0ULL;
+        }
+    }
+    ws_spin_unlock(&g_blocks_lock);
+}
+
+#else
+
+int wsclock_stats_snapshot(WSClockStatsSnapshot* snapshot)
+{
+    if (snapshot) memset(snapshot, 0, sizeof(WSClockStatsSnapshot));
+    return -1;
+}
+
+int wsclock_stats_process(const WSClockEnvironment* env, int process_index, WSClockProcCounters* counters)
+{
+    (void)env;
+    (void)process_index;
+    if (counters) memset(counters, 0, sizeof(WSClockProcCounters));
+    return -1;
+}
+
+void wsclock_stats_reset(void)
+{
+}
+
+#endif /* WSCLOCK_STATS */
@@ -0,0 +1,136 @@
+#ifndef WSCLOCK_STATS_H
+#define WSCLOCK_STATS_H
+
+#include "wsclock_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 热路径插桩的编译开关：默认打开，编译时加 -DWSCLOCK_STATS=0 可去掉全部插桩代码，
+ * 此时查询接口仍然存在，但只返回 -1
+ */
+#ifndef WSCLOCK_STATS
+#define WSCLOCK_STATS 1
+#endif
+
+/*
+ * 计时采样：每个线程每 2^WSCLOCK_STATS_SAMPLE_SHIFT 次调用计时一次(计数器不采样，始终精确)
+ * 读计时器本身有几十纳秒的开销，与命中路径相当；设为0则每次调用都计时
+ */
+#ifndef WSCLOCK_STATS_SAMPLE_SHIFT
+#define WSCLOCK_STATS_SAMPLE_SHIFT 3
+#endif
+
+/*
+ * 被计时的接口
+ */
+#define WSCLOCK_OP_ACCESS_HIT    0   /* wsclock_access_page(_ex) 命中 */
+#define WSCLOCK_OP_ACCESS_FAULT  1   /* wsclock_access_page(_ex) 缺页(含等锁与置换) */
+#define WSCLOCK_OP_FIND_VICTIM   2   /* find_victim_page */
+#define WSCLOCK_OP_PERIODIC_SCAN 3   /* wsclock_periodic_scan */
+#define WSCLOCK_OP_SCAN_BUDGET   4   /* wsclock_periodic_scan_budget */
+#define WSCLOCK_OP_COUNT         5
+
+/*
+ * 对数-线性分桶：小于8的值各占一桶，之后每个2的幂区间再等分为8个子桶，
+ * 相对误差不超过 12.5%；超出范围的值计入最后一桶
+ */
+#define WSCLOCK_HIST_SUB_BITS 3
+#define WSCLOCK_HIST_BUCKETS  320
+
+typedef struct WSClockHistogram {
+    unsigned long long count;        /* 计时的样本数(采样后约为调用次数的 1/2^SAMPLE_SHIFT) */
+    unsigned long long sum;          /* 单位同 buckets：计数器滴答 */
+    unsigned long long min;
+    unsigned long long max;
+    unsigned long long buckets[WSCLOCK_HIST_BUCKETS];
+} WSClockHistogram;
+
+/*
+ * 快照：合并所有线程的直方图
+ *  - ticks_per_ns: 计时源(x86 上为 rdtsc，其他平台为单调时钟纳秒)与纳秒的换算比例
+ */
+typedef struct WSClockStatsSnapshot {
+    WSClockHistogram ops[WSCLOCK_OP_COUNT];
+    double ticks_per_ns;
+    int threads;                     /* 记录过数据的线程数 */
+} WSClockStatsSnapshot;
+
+/*
+ * 获取所有线程直方图的快照。采样线程可能仍在写，快照中各字段分别一致即可
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 插桩未编译
+ */
+int wsclock_stats_snapshot(WSClockStatsSnapshot* snapshot);
+
+/*
+ * 获取进程计数器(hits 由进程时钟推算)
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或插桩未编译
+ */
+int wsclock_stats_process(const WSClockEnvironment* env, int process_index, WSClockProcCounters* counters);
+
+/*
+ * 直方图的分位数(p 取 0~1)，返回纳秒
+ */
+double wsclock_hist_percentile(const WSClockHistogram* hist, double p, double ticks_per_ns);
+
+/*
+ * 清空所有线程的直方图(只应在没有其他线程记录时调用)
+ */
+void wsclock_stats_reset(void);
+
+/*
+ * 以下为插桩内部使用
+ */
+#if WSCLOCK_STATS
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define WSCLOCK_STATS_HAVE_TSC 1
+static inline unsigned long long wsclock_stats_ticks(void) { return __rdtsc(); }
+#else
+#include "wsclock_time.h"
+static inline unsigned long long wsclock_stats_ticks(void) { return wsclock_now_ns(); }
+#endif
+
+void wsclock_stats_record(int op, unsigned long long ticks);
+
+#if defined(_MSC_VER)
+extern __declspec(thread) unsigned int wsclock_stats_sample_tick;
+#else
+extern __thread unsigned int wsclock_stats_sample_tick;
+#endif
+
+/* 本次调用是否计时；不计时的调用返回0 */
+static inline unsigned long long wsclock_stats_begin(void)
+{
+    if ((wsclock_stats_sample_tick++ & ((1u << WSCLOCK_STATS_SAMPLE_SHIFT) - 1)) != 0) {
+        return 0;
+    }
+    return wsclock_stats_ticks() | 1;  /* 保证非0 */
+}
+
+#define WSCLOCK_STATS_START(var)      unsigned long long var = wsclock_stats_begin()
+#define WSCLOCK_STATS_END(op, var) \
+    do { if (var) wsclock_stats_record((op), wsclock_stats_ticks() - (var)); } while (0)
+/* 计数器只由持有置换锁的线程或唯一的扫描者写，读者用原子读取快照 */
+#define WSCLOCK_STATS_ADD(field, v)   WS_ATOMIC_STORE(&(field), WS_ATOMIC_LOAD(&(field)) + (v))
+
+#else
+
+#define WSCLOCK_STATS_START(var)      ((void)0)
+#define WSCLOCK_STATS_END(op, var)    ((void)0)
+#define WSCLOCK_STATS_ADD(field, v)   ((void)0)
+
+#endif /* WSCLOCK_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_STATS_H */
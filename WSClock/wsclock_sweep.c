@@ -0,0 +1,320 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "wsclock_sweep.h"
+#include "wsclock_kernel.h"
+#include "wsclock_atomic.h"
+#include "wsclock_time.h"
+
+/*
+ * 解析单个维度的取值："a"、"a,b,c"、"a:b"、"a:b:step"
+ */
+static int sweep_parse_axis(const char* text, WSClockSweepAxis* axis)
+{
+    axis->count = 0;
+    if (strchr(text, ':')) {
+        int a, b, step = 1;
+        char tail;
+        int n = sscanf(text, "%d:%d:%d%c", &a, &b, &step, &tail);
+        if (n != 2 && n != 3) return -1;
+        if (step <= 0 || b < a) return -1;
+        for (int v = a; v <= b; v += step) {
+            if (axis->count >= WSCLOCK_SWEEP_MAX_VALUES) return -1;
+            axis->values[axis->count++] = v;
+        }
+        return 0;
+    }
+
+    /* 逗号分隔的列表 */
+    const char* p = text;
+    while (*p) {
+        char* end;
+        long v = strtol(p, &end, 10);
+        if (end == p || axis->count >= WSCLOCK_SWEEP_MAX_VALUES) return -1;
+        axis->values[axis->count++] = (int)v;
+        if (*end == ',') {
+            p = end + 1;
+        } else if (*end == '\0') {
+            break;
+        } else {
+            return -1;
+        }
+    }
+    return axis->count > 0 ? 0 : -1;
+}
+
+int wsclock_sweep_parse(const char* spec, const WSClockSweepPoint* defaults, WSClockSweepGrid* grid)
+{
+    if (!spec || !defaults || !grid) return -1;
+
+    grid->procs.count = 1;
+    grid->procs.values[0] = defaults->process_count;
+    grid->pages.count = 1;
+    grid->pages.values[0] = defaults->page_count;
+    grid->ws.count = 1;
+    grid->ws.values[0] = defaults->working_set_size;
+    grid->tau.count = 1;
+    grid->tau.values[0] = defaults->scan_period;
+
+    char token[256];
+    const char* p = spec;
+    while (*p) {
+        while (*p == ' ' || *p == ';' || *p == '\t') p++;
+        if (!*p) break;
+        int len = 0;
+        while (p[len] && p[len] != ' ' && p[len] != ';' && p[len] != '\t') len++;
+        if (len >= (int)sizeof(token)) return -1;
+        memcpy(token, p, (size_t)len);
+        token[len] = '\0';
+        p += len;
+
+        char* eq = strchr(token, '=');
+        if (!eq) return -1;
+        *eq = '\0';
+        WSClockSweepAxis* axis;
+        if (strcmp(token, "procs") == 0) axis = &grid->procs;
+        else if (strcmp(token, "pages") == 0) axis = &grid->pages;
+        else if (strcmp(token, "ws") == 0) axis = &grid->ws;
+        else if (strcmp(token, "tau") == 0) axis = &grid->tau;
+        else return -1;
+        if (sweep_parse_axis(eq + 1, axis) != 0) return -1;
+    }
+
+    /* 所有取值必须为正 */
+    const WSClockSweepAxis* axes[4] = { &grid->procs, &grid->pages, &grid->ws, &grid->tau };
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < axes[i]->count; j++) {
+            if (axes[i]->values[j] <= 0) return -1;
+        }
+    }
+    return 0;
+}
+
+int wsclock_sweep_expand(const WSClockSweepGrid* grid, WSClockSweepPoint** out_points)
+{
+    if (!grid || !out_points) return -1;
+    long total = (long)grid->procs.count * grid->pages.count * grid->ws.count * grid->tau.count;
+    if (total <= 0 || total > 10000000L) return -1;
+
+    WSClockSweepPoint* points = (WSClockSweepPoint*)calloc((size_t)total, sizeof(WSClockSweepPoint));
+    if (!points) return -1;
+
+    int k = 0;
+    for (int a = 0; a < grid->procs.count; a++)
+        for (int b = 0; b < grid->pages.count; b++)
+            for (int c = 0; c < grid->ws.count; c++)
+                for (int d = 0; d < grid->tau.count; d++) {
+                    points[k].process_count = grid->procs.values[a];
+                    points[k].page_count = grid->pages.values[b];
+                    points[k].working_set_size = grid->ws.values[c];
+                    points[k].scan_period = grid->tau.values[d];
+                    k++;
+                }
+    *out_points = points;
+    return k;
+}
+
+/*
+ * 模拟一个配置点：与 main.c 的轮转调度相同，只是不打印过程
+ */
+static void sweep_simulate_point(WSClockSweepPoint* pt,
+                                 const int* sequence,
+                                 const unsigned char* writes,
+                                 int length,
+                                 const WSClockTimingConfig* timing)
+{
+    unsigned long long start_ns = wsclock_now_ns();
+    int n = pt->process_count;
+    pt->status = -1;
+
+    Process* procs = (Process*)calloc((size_t)n, sizeof(Process));
+    int pages_ok = procs != NULL;
+    for (int i = 0; pages_ok && i < n; i++) {
+        pages_ok = wsclock_page_table_init(&procs[i], NULL, pt->page_count) == 0;
+    }
+    WSClockTimingModel model;
+    int timing_ok = pages_ok && timing && wsclock_timing_init(&model, timing, n) == 0;
+    if (!pages_ok || (timing && !timing_ok)) {
+        /* 分配失败：status 保持 -1，由 wsclock_sweep_run 报告，不输出全零的结果 */
+        for (int i = 0; procs && i < n; i++) wsclock_page_table_release(&procs[i], NULL);
+        free(procs);
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        procs[i].process_id = i;
+        procs[i].working_set_size = pt->working_set_size;
+        procs[i].active = 1;
+    }
+    WSClockEnvironment env;
+    memset(&env, 0, sizeof(env));
+    wsclock_init(&env, procs, n, 0);
+
+    int current = 0;
+    for (int i = 0; i < length; i++) {
+        int result = wsclock_access_page_ex(&env, current, sequence[i], writes ? writes[i] : 0, 0);
+        if (result != WSCLOCK_ACCESS_INVALID) {
+            pt->refs++;
+            if (result & WSCLOCK_ACCESS_FAULT) pt->faults++;
+            if (result & WSCLOCK_ACCESS_WRITEBACK) pt->writebacks++;
+            if (timing_ok) wsclock_timing_record(&model, current, result);
+        }
+        current = (current + 1) % n;
+        if ((i + 1) % pt->scan_period == 0) {
+            for (int pi = 0; pi < n; pi++) {
+                wsclock_periodic_scan(&env, pi);
+            }
+        }
+    }
+
+    pt->fault_rate = pt->refs ? (double)pt->faults / (double)pt->refs : 0.0;
+    if (timing_ok) {
+        WSClockTimingReport report;
+        wsclock_timing_report(&model, &report);
+        pt->effective_access_ns = report.effective_access_ns;
+        pt->device_utilization = report.device_utilization;
+        wsclock_timing_free(&model);
+    }
+    wsclock_cleanup(&env);
+    for (int i = 0; i < n; i++) wsclock_page_table_release(&procs[i], NULL);
+    free(procs);
+    pt->elapsed_ns = wsclock_now_ns() - start_ns;
+    pt->status = 0;
+}
+
+/*
+ * 每个工作线程的任务区间 [next, end)；owner 和窃取者都用原子加从 next 处取任务
+ * 填充到缓存行大小，避免不同线程的计数器伪共享
+ */
+typedef struct SweepQueue {
+    long next;
+    long end;
+    char pad[64 - 2 * sizeof(long)];
+} SweepQueue;
+
+typedef struct SweepShared {
+    WSClockSweepPoint* points;
+    const int* sequence;
+    const unsigned char* writes;
+    int length;
+    const WSClockTimingConfig* timing;
+    SweepQueue* queues;
+    int worker_count;
+} SweepShared;
+
+typedef struct SweepWorker {
+    pthread_t thread;
+    SweepShared* shared;
+    int self;
+} SweepWorker;
+
+/* 从第 q 个队列取一个任务，队列已空时返回-1 */
+static long sweep_take(SweepQueue* q)
+{
+    if (WS_ATOMIC_LOAD(&q->next) >= q->end) return -1;
+    long i = WS_ATOMIC_FETCH_ADD(&q->next, 1L);
+    return i < q->end ? i : -1;
+}
+
+static void* sweep_worker_main(void* arg)
+{
+    SweepWorker* w = (SweepWorker*)arg;
+    SweepShared* sh = w->shared;
+    for (;;) {
+        long i = sweep_take(&sh->queues[w->self]);
+        for (int k = 1; i < 0 && k < sh->worker_count; k++) {
+            /* 自己的区间做完了，依次从其他线程的区间窃取 */
+            i = sweep_take(&sh->queues[(w->self + k) % sh->worker_count]);
+        }
+        if (i < 0) break;
+        sweep_simulate_point(&sh->points[i], sh->sequence, sh->writes, sh->length, sh->timing);
+    }
+    return 0;
+}
+
+int wsclock_sweep_run(WSClockSweepPoint* points,
+                      int point_count,
+                      const int* sequence,
+                      const unsigned char* writes,
+                      int length,
+                      const WSClockTimingConfig* timing,
+                      int thread_count)
+{
+    if (!points || point_count <= 0 || !sequence || length <= 0) return -1;
+    if (thread_count <= 0) thread_count = 1;
+    if (thread_count > point_count) thread_count = point_count;
+
+    SweepShared sh;
+    sh.points = points;
+    sh.sequence = sequence;
+    sh.writes = writes;
+    sh.length = length;
+    sh.timing = timing;
+    sh.worker_count = thread_count;
+    sh.queues = (SweepQueue*)calloc((size_t)thread_count, sizeof(SweepQueue));
+    SweepWorker* workers = (SweepWorker*)calloc((size_t)thread_count, sizeof(SweepWorker));
+    if (!sh.queues || !workers) {
+        free(sh.queues);
+        free(workers);
+        return -1;
+    }
+
+    /* 初始均分：每个线程一段连续的配置点 */
+    for (int t = 0; t < thread_count; t++) {
+        sh.queues[t].next = (long)point_count * t / thread_count;
+        sh.queues[t].end = (long)point_count * (t + 1) / thread_count;
+    }
+
+    int started = 0;
+    for (int t = 0; t < thread_count; t++) {
+        workers[t].shared = &sh;
+        workers[t].self = t;
+        if (pthread_create(&workers[t].thread, 0, sweep_worker_main, &workers[t]) != 0) {
+            break;
+        }
+        started++;
+    }
+    if (started == 0) {
+        /* 无法创建线程时在当前线程完成全部工作(会把所有区间都窃取完) */
+        sweep_worker_main(&workers[0]);
+    }
+    /* 部分线程创建失败时，已启动的线程会把其余线程的区间窃取完 */
+    for (int t = 0; t < started; t++) {
+        pthread_join(workers[t].thread, 0);
+    }
+
+    free(sh.queues);
+    free(workers);
+    for (int i = 0; i < point_count; i++) {
+        if (points[i].status != 0) return -1;
+    }
+    return 0;
+}
+
+void wsclock_sweep_write_csv(FILE* fp, const WSClockSweepPoint* points, int point_count)
+{
+    fprintf(fp, "procs,pages,ws,tau,refs,faults,writebacks,fault_rate,eat_ns,device_util,sim_ms\n");
+    for (int i = 0; i < point_count; i++) {
+        const WSClockSweepPoint* p = &points[i];
+        fprintf(fp, "%d,%d,%d,%d,%llu,%llu,%llu,%.6f,%.1f,%.4f,%.3f\n",
+                p->process_count, p->page_count, p->working_set_size, p->scan_period,
+                p->refs, p->faults, p->writebacks, p->fault_rate,
+                p->effective_access_ns, p->device_utilization, (double)p->elapsed_ns / 1e6);
+    }
+}
+
+void wsclock_sweep_write_json(FILE* fp, const WSClockSweepPoint* points, int point_count)
+{
+    fprintf(fp, "[\n");
+    for (int i = 0; i < point_count; i++) {
+        const WSClockSweepPoint* p = &points[i];
+        fprintf(fp, "  {\"procs\": %d, \"pages\": %d, \"ws\": %d, \"tau\": %d, "
+                    "\"refs\": %llu, \"faults\": %llu, \"writebacks\": %llu, \"fault_rate\": %.6f, "
+                    "\"eat_ns\": %.1f, \"device_util\": %.4f, \"sim_ms\": %.3f}%s\n",
+                p->process_count, p->page_count, p->working_set_size, p->scan_period,
+                p->refs, p->faults, p->writebacks, p->fault_rate,
+                p->effective_access_ns, p->device_utilization, (double)p->elapsed_ns / 1e6,
+                i + 1 < point_count ? "," : "");
+    }
+    fprintf(fp, "]\n");
+}
@@ -0,0 +1,96 @@
+#ifndef WSCLOCK_SWEEP_H
+#define WSCLOCK_SWEEP_H
+
+#include <stdio.h>
+#include "wsclock_timing.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 参数扫描中的一个配置点及其结果
+ */
+typedef struct WSClockSweepPoint {
+    /* 配置 */
+    int process_count;
+    int page_count;
+    int working_set_size;
+    int scan_period;                 /* τ：每隔多少次访问清理一次引用位 */
+
+    /* 结果 */
+    int status;                      /* 0: 成功；-1: 页表或时延模型分配失败，其余结果无效 */
+    unsigned long long refs;
+    unsigned long long faults;
+    unsigned long long writebacks;
+    double fault_rate;
+    double effective_access_ns;      /* 时延模型给出的有效访问时间 */
+    double device_utilization;
+    unsigned long long elapsed_ns;   /* 模拟该配置所用的实际时间 */
+} WSClockSweepPoint;
+
+/*
+ * 扫描网格：每个维度是一组取值
+ */
+#define WSCLOCK_SWEEP_MAX_VALUES 1024
+
+typedef struct WSClockSweepAxis {
+    int values[WSCLOCK_SWEEP_MAX_VALUES];
+    int count;
+} WSClockSweepAxis;
+
+typedef struct WSClockSweepGrid {
+    WSClockSweepAxis procs;   /* 进程数 */
+    WSClockSweepAxis pages;   /* 每进程页数 */
+    WSClockSweepAxis ws;      /* 工作集容量 */
+    WSClockSweepAxis tau;     /* 扫描周期 */
+} WSClockSweepGrid;
+
+/*
+ * 解析网格描述，各维度以空格或分号分隔，例如:
+ *   "ws=2:8 tau=1:10 procs=1:4 pages=20"
+ * 取值格式: "a"、"a,b,c"、"a:b"(步长1)或"a:b:step"
+ * 未给出的维度使用 defaults 中对应的单个取值
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 格式错误
+ */
+int wsclock_sweep_parse(const char* spec, const WSClockSweepPoint* defaults, WSClockSweepGrid* grid);
+
+/*
+ * 展开网格得到所有配置点(调用方负责 free)
+ * 返回值: 配置点个数，失败返回-1
+ */
+int wsclock_sweep_expand(const WSClockSweepGrid* grid, WSClockSweepPoint** out_points);
+
+/*
+ * 在线程池上并行运行所有配置点
+ *  - 所有配置共享同一份只读的引用序列(按轮转方式分配给各进程，与 main.c 一致)
+ *  - 每个配置使用独立的 WSClockEnvironment，互不影响
+ *  - 每个工作线程先处理自己的一段配置点，做完后从其他线程窃取剩余的点
+ * 参数:
+ *   - writes: 可为NULL；非NULL时 writes[i] 表示第i次访问为写
+ *   - thread_count: <=0 时使用1个线程
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法，或有配置点模拟失败(见各点的 status)
+ */
+int wsclock_sweep_run(WSClockSweepPoint* points,
+                      int point_count,
+                      const int* sequence,
+                      const unsigned char* writes,
+                      int length,
+                      const WSClockTimingConfig* timing,
+                      int thread_count);
+
+/*
+ * 输出结果表
+ */
+void wsclock_sweep_write_csv(FILE* fp, const WSClockSweepPoint* points, int point_count);
+void wsclock_sweep_write_json(FILE* fp, const WSClockSweepPoint* points, int point_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_SWEEP_H */
@@ -0,0 +1,79 @@
+#include <stdlib.h>
+#include <pthread.h>
+#include "wsclock_threads.h"
+#include "wsclock_time.h"
+
+/* 单个回放线程的参数 */
+typedef struct ReplayWorker {
+    pthread_t thread;
+    WSClockEnvironment* env;
+    int process_index;
+    const int* sequence;
+    int length;
+    int offset;      /* 起始偏移，使各线程访问序列错开 */
+    int rounds;
+    unsigned long long done;
+} ReplayWorker;
+
+static void* replay_thread_main(void* arg)
+{
+    ReplayWorker* w = (ReplayWorker*)arg;
+    for (int r = 0; r < w->rounds; r++) {
+        for (int i = 0; i < w->length; i++) {
+            int idx = (w->offset + i) % w->length;
+            wsclock_access_page(w->env, w->process_index, w->sequence[idx]);
+        }
+        w->done += (unsigned long long)w->length;
+    }
+    return 0;
+}
+
+int wsclock_run_threaded(WSClockEnvironment* env,
+                         int process_index,
+                         const int* sequence,
+                         int length,
+                         int thread_count,
+                         int rounds,
+                         WSClockThreadRunStats* stats)
+{
+    if (!env || !sequence || length <= 0 || thread_count <= 0 || rounds <= 0) {
+        return -1;
+    }
+    if (process_index < 0 || process_index >= env->process_count) {
+        return -1;
+    }
+
+    ReplayWorker* workers = (ReplayWorker*)calloc((size_t)thread_count, sizeof(ReplayWorker));
+    if (!workers) return -1;
+
+    unsigned long long start_ns = wsclock_now_ns();
+    int started = 0;
+    for (int t = 0; t < thread_count; t++) {
+        workers[t].env = env;
+        workers[t].process_index = process_index;
+        workers[t].sequence = sequence;
+        workers[t].length = length;
+        workers[t].offset = (int)((long long)length * t / thread_count);
+        workers[t].rounds = rounds;
+        if (pthread_create(&workers[t].thread, 0, replay_thread_main, &workers[t]) != 0) {
+            break;
+        }
+        started++;
+    }
+
+    unsigned long long total = 0;
+    for (int t = 0; t < started; t++) {
+        pthread_join(workers[t].thread, 0);
+        total += workers[t].done;
+    }
+    unsigned long long elapsed = wsclock_now_ns() - start_ns;
+    free(workers);
+
+    if (stats) {
+        stats->threads = started;
+        stats->references = total;
+        stats->elapsed_ns = elapsed;
+        stats->refs_per_sec = elapsed > 0 ? (double)total * 1e9 / (double)elapsed : 0.0;
+    }
+    return started == thread_count ? 0 : -1;
+}
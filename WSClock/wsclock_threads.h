@@ -0,0 +1,42 @@
+#ifndef WSCLOCK_THREADS_H
+#define WSCLOCK_THREADS_H
+
+#include "wsclock_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 多线程回放的统计结果
+ */
+typedef struct WSClockThreadRunStats {
+    int threads;                     /* 实际运行的线程数 */
+    unsigned long long references;   /* 所有线程完成的访问总数 */
+    unsigned long long elapsed_ns;   /* 从启动到全部线程结束的耗时 */
+    double refs_per_sec;             /* 吞吐量(次访问/秒) */
+} WSClockThreadRunStats;
+
+/*
+ * 模拟多线程进程：thread_count 个线程共享同一地址空间(同一进程)，
+ * 各自从序列的不同偏移开始循环回放 rounds 遍，并发调用 wsclock_access_page。
+ * 参数:
+ *   - sequence/length: 页面访问序列(只读，线程间共享)
+ *   - stats: 可为NULL
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或线程创建失败
+ */
+int wsclock_run_threaded(WSClockEnvironment* env,
+                         int process_index,
+                         const int* sequence,
+                         int length,
+                         int thread_count,
+                         int rounds,
+                         WSClockThreadRunStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_THREADS_H */
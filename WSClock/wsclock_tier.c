@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include <string.h>
+#include "wsclock_tier.h"
+
+int wsclock_tier_init(WSClockTierModel* model,
+                      const WSClockTierConfig* config,
+                      const WSClockEnvironment* env)
+{
+    if (!model || !config || !env || env->process_count <= 0) return -1;
+
+    memset(model, 0, sizeof(WSClockTierModel));
+    model->config = *config;
+    if (model->config.zpool_pages < 0) {
+        model->config.zpool_pages = 0;
+    }
+    model->process_count = env->process_count;
+    model->zhead = -1;
+    model->ztail = -1;
+
+    model->page_base = (int*)calloc((size_t)env->process_count, sizeof(int));
+    model->page_count = (int*)calloc((size_t)env->process_count, sizeof(int));
+    model->clock = (unsigned long*)calloc((size_t)env->process_count, sizeof(unsigned long));
+    if (!model->page_base || !model->page_count || !model->clock) {
+        wsclock_tier_free(model);
+        return -1;
+    }
+    for (int p = 0; p < env->process_count; p++) {
+        model->page_base[p] = model->total_pages;
+        model->page_count[p] = env->processes[p].page_count > 0 ? env->processes[p].page_count : 0;
+        model->total_pages += model->page_count[p];
+    }
+
+    size_t n = model->total_pages > 0 ? (size_t)model->total_pages : 1;
+    model->tier = (unsigned char*)calloc(n, sizeof(unsigned char));
+    model->swap_copy = (unsigned char*)calloc(n, sizeof(unsigned char));
+    model->last_ref = (unsigned long*)calloc(n, sizeof(unsigned long));
+    model->zprev = (int*)malloc(sizeof(int) * n);
+    model->znext = (int*)malloc(sizeof(int) * n);
+    if (!model->tier || !model->swap_copy || !model->last_ref || !model->zprev || !model->znext) {
+        wsclock_tier_free(model);
+        return -1;
+    }
+
+    for (int p = 0; p < env->process_count; p++) {
+        const Process* proc = &env->processes[p];
+        for (int i = 0; proc->page_dir && i < model->page_count[p]; i++) {
+            if (wsclock_page(proc, i)->in_working_set) {
+                model->tier[model->page_base[p] + i] = WSCLOCK_TIER_DRAM;
+            }
+        }
+    }
+    return 0;
+}
+
+/* 从压缩池链表中摘除 */
+static void zpool_unlink(WSClockTierModel* m, int g)
+{
+    if (m->zprev[g] >= 0) m->znext[m->zprev[g]] = m->znext[g];
+    else m->zhead = m->znext[g];
+    if (m->znext[g] >= 0) m->zprev[m->znext[g]] = m->zprev[g];
+    else m->ztail = m->zprev[g];
+    m->stats.zpool_used--;
+}
+
+/* 放到压缩池链表头部 */
+static void zpool_push(WSClockTierModel* m, int g)
+{
+    m->zprev[g] = -1;
+    m->znext[g] = m->zhead;
+    if (m->zhead >= 0) m->zprev[m->zhead] = g;
+    m->zhead = g;
+    if (m->ztail < 0) m->ztail = g;
+    m->stats.zpool_used++;
+    if (m->stats.zpool_used > m->stats.zpool_peak) {
+        m->stats.zpool_peak = m->stats.zpool_used;
+    }
+}
+
+/* 页面进入交换设备：没有有效的交换副本时需要写出，返回开销 */
+static unsigned long long move_to_swap(WSClockTierModel* m, int g)
+{
+    unsigned long long cost = 0;
+    m->tier[g] = WSCLOCK_TIER_SWAP;
+    if (!m->swap_copy[g]) {
+        m->swap_copy[g] = 1;
+        m->stats.swap_outs++;
+        cost = m->config.swap_out_ns;
+    }
+    return cost;
+}
+
+/*
+ * 降级被置换的页：仍在工作集窗口内的进入压缩池，否则直接换出
+ */
+static unsigned long long demote(WSClockTierModel* m, int process_index, int g, int dirty)
+{
+    unsigned long long cost = 0;
+    if (dirty) {
+        m->swap_copy[g] = 0; /* 内容已改变，旧的交换副本失效 */
+    }
+
+    unsigned long idle = m->clock[process_index] - m->last_ref[g];
+    int warm = m->config.ws_window == 0 || idle <= m->config.ws_window;
+    if (m->config.zpool_pages <= 0 || !warm) {
+        m->stats.swap_demotions++;
+        return move_to_swap(m, g);
+    }
+
+    /* 压缩池已满：最久未用的页挤到交换设备 */
+    if (m->stats.zpool_used >= m->config.zpool_pages) {
+        int old = m->ztail;
+        zpool_unlink(m, old);
+        m->stats.zpool_evictions++;
+        cost += move_to_swap(m, old);
+    }
+    m->tier[g] = WSCLOCK_TIER_ZPOOL;
+    zpool_push(m, g);
+    m->stats.zpool_demotions++;
+    cost += m->config.zpool_store_ns;
+    return cost;
+}
+
+unsigned long long wsclock_tier_record(WSClockTierModel* model,
+                                       int process_index,
+                                       int page,
+                                       int access_flags,
+                                       int victim_page)
+{
+    if (!model || access_flags == WSCLOCK_ACCESS_INVALID) return 0;
+    if (process_index < 0 || process_index >= model->process_count) return 0;
+    if (page < 0 || page >= model->page_count[process_index]) return 0;
+
+    int base = model->page_base[process_index];
+    int g = base + page;
+    unsigned long long cost = model->config.dram_ns;
+    model->stats.refs++;
+    model->clock[process_index]++;
+
+    if (access_flags & WSCLOCK_ACCESS_FAULT) {
+        /* 先降级被置换的页，再把目标页从所在层级提升回来 */
+        if (victim_page >= 0 && victim_page < model->page_count[process_index]) {
+            cost += demote(model, process_index, base + victim_page,
+                           (access_flags & WSCLOCK_ACCESS_WRITEBACK) != 0);
+        }
+
+        switch (model->tier[g]) {
+        case WSCLOCK_TIER_ZPOOL:
+            zpool_unlink(model, g);
+            model->stats.zpool_promotions++;
+            cost += model->config.zpool_load_ns;
+            break;
+        case WSCLOCK_TIER_SWAP:
+            model->stats.swap_ins++;
+            cost += model->config.swap_in_ns;
+            break;
+        case WSCLOCK_TIER_DRAM:
+            /* 模型与 WSClock 状态不一致(例如中途接入)，按命中计 */
+            break;
+        default:
+            model->stats.cold_faults++;
+            break;
+        }
+        model->tier[g] = WSCLOCK_TIER_DRAM;
+    } else {
+        model->stats.dram_hits++;
+        model->tier[g] = WSCLOCK_TIER_DRAM;
+    }
+
+    model->last_ref[g] = model->clock[process_index];
+    model->stats.total_ns += cost;
+    return cost;
+}
+
+int wsclock_tier_of(const WSClockTierModel* model, int process_index, int page)
+{
+    if (!model || process_index < 0 || process_index >= model->process_count) return -1;
+    if (page < 0 || page >= model->page_count[process_index]) return -1;
+    return model->tier[model->page_base[process_index] + page];
+}
+
+void wsclock_tier_report(const WSClockTierModel* model, WSClockTierStats* stats)
+{
+    if (!model || !stats) return;
+    *stats = model->stats;
+    stats->effective_access_ns = stats->refs
+        ? (double)stats->total_ns / (double)stats->refs : 0.0;
+}
+
+void wsclock_tier_free(WSClockTierModel* model)
+{
+    if (!model) return;
+    free(model->page_base);
+    free(model->page_count);
+    free(model->clock);
+    free(model->tier);
+    free(model->swap_copy);
+    free(model->last_ref);
+    free(model->zprev);
+    free(model->znext);
+    model->page_base = 0;
+    model->page_count = 0;
+    model->clock = 0;
+    model->tier = 0;
+    model->swap_copy = 0;
+    model->last_ref = 0;
+    model->zprev = 0;
+    model->znext = 0;
+}
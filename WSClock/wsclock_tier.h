@@ -0,0 +1,118 @@
+#ifndef WSCLOCK_TIER_H
+#define WSCLOCK_TIER_H
+
+#include "wsclock_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 页面所在的层级
+ */
+#define WSCLOCK_TIER_NONE   0   /* 从未访问过(首次访问为零页填充) */
+#define WSCLOCK_TIER_DRAM   1   /* 在工作集中 */
+#define WSCLOCK_TIER_ZPOOL  2   /* 压缩内存池(类似 zswap) */
+#define WSCLOCK_TIER_SWAP   3   /* 交换设备 */
+
+/*
+ * 分层内存模型的配置(时间单位：纳秒)
+ */
+typedef struct WSClockTierConfig {
+    unsigned long dram_ns;         /* 内存命中延迟 */
+    int zpool_pages;               /* 压缩池容量(页，所有进程共享)，0 表示没有压缩层 */
+    unsigned long zpool_load_ns;   /* 从压缩池提升一页(解压) */
+    unsigned long zpool_store_ns;  /* 降级一页到压缩池(压缩) */
+    unsigned long swap_in_ns;      /* 从交换设备读入一页 */
+    unsigned long swap_out_ns;     /* 向交换设备写出一页 */
+    unsigned long ws_window;       /* τ：被置换页距上次访问不超过τ次(本进程)访问时仍属于工作集，
+                                      进入压缩池；否则直接换出。0 表示全部进入压缩池
+                                      (main.c 未指定时取扫描周期) */
+} WSClockTierConfig;
+
+/*
+ * 分层统计
+ */
+typedef struct WSClockTierStats {
+    unsigned long long refs;
+    unsigned long long dram_hits;
+    unsigned long long cold_faults;       /* 首次访问 */
+    unsigned long long zpool_promotions;  /* 从压缩池提升(廉价缺页) */
+    unsigned long long swap_ins;          /* 从交换设备读入(昂贵缺页) */
+    unsigned long long zpool_demotions;   /* 被置换页进入压缩池 */
+    unsigned long long swap_demotions;    /* 被置换页因不在工作集窗口内直接换出 */
+    unsigned long long zpool_evictions;   /* 压缩池满时最久未用的页被挤到交换设备 */
+    unsigned long long swap_outs;         /* 实际的交换写出次数(干净且已有交换副本的页不需写出) */
+    int zpool_used;
+    int zpool_peak;
+    unsigned long long total_ns;          /* 所有访问的累计时间 */
+    double effective_access_ns;
+} WSClockTierStats;
+
+/*
+ * 分层内存模型：由模拟过程逐次驱动，不改变 WSClock 的置换决策
+ *  - 工作集内的页在 DRAM 中；find_victim_page 选出的页按工作集窗口降级到压缩池或交换设备
+ *  - 压缩池按 LRU 组织，满时把最久未用的页挤到交换设备
+ *  - 缺页时页面从所在层级提升回 DRAM
+ *  - 每个页面记录是否有有效的交换副本：干净页再次换出时不需要写
+ */
+typedef struct WSClockTierModel {
+    WSClockTierConfig config;
+    int process_count;
+    int* page_base;                /* 各进程页面在下列数组中的起始下标 */
+    int* page_count;
+    int total_pages;
+    unsigned char* tier;
+    unsigned char* swap_copy;
+    unsigned long* last_ref;       /* 按进程自己的访问计数记录的最近访问时刻 */
+    unsigned long* clock;          /* 每个进程的访问计数 */
+    int* zprev;                    /* 压缩池 LRU 双向链表 */
+    int* znext;
+    int zhead;                     /* 最近放入的页 */
+    int ztail;                     /* 最久未用的页 */
+    WSClockTierStats stats;
+} WSClockTierModel;
+
+/*
+ * 初始化分层模型，按 env 中各进程的页数分配状态；已在工作集中的页视为在 DRAM 中
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或内存不足
+ */
+int wsclock_tier_init(WSClockTierModel* model,
+                      const WSClockTierConfig* config,
+                      const WSClockEnvironment* env);
+
+/*
+ * 记录一次访问
+ * 参数:
+ *   - access_flags: wsclock_access_page_ex 的返回值，WSCLOCK_ACCESS_INVALID 时忽略
+ *   - victim_page: wsclock_access_page_ex 输出的被置换页号(无置换时为-1)
+ * 返回值: 本次访问的时间(纳秒)，包括同步完成的降级开销
+ */
+unsigned long long wsclock_tier_record(WSClockTierModel* model,
+                                       int process_index,
+                                       int page,
+                                       int access_flags,
+                                       int victim_page);
+
+/*
+ * 查询页面当前所在层级(WSCLOCK_TIER_*)，参数非法时返回-1
+ */
+int wsclock_tier_of(const WSClockTierModel* model, int process_index, int page);
+
+/*
+ * 填写汇总统计(计算有效访问时间)
+ */
+void wsclock_tier_report(const WSClockTierModel* model, WSClockTierStats* stats);
+
+/*
+ * 释放分层模型
+ */
+void wsclock_tier_free(WSClockTierModel* model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_TIER_H */
@@ -0,0 +1,53 @@
+#ifndef WSCLOCK_TIME_H
+#define WSCLOCK_TIME_H
+
+/*
+ * 计时辅助：提供单调时钟(纳秒)与简单的休眠函数
+ *  - Windows 下使用 QueryPerformanceCounter / Sleep
+ *  - 其他平台使用 clock_gettime(CLOCK_MONOTONIC) / nanosleep
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/*
+ * 返回单调时钟的当前值(纳秒)，只用于计算时间差
+ */
+static inline unsigned long long wsclock_now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (freq.QuadPart == 0) {
+        QueryPerformanceFrequency(&freq);
+    }
+    QueryPerformanceCounter(&now);
+    return (unsigned long long)(now.QuadPart / freq.QuadPart) * 1000000000ULL
+         + (unsigned long long)(now.QuadPart % freq.QuadPart) * 1000000000ULL
+           / (unsigned long long)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+/*
+ * 休眠指定微秒数(精度取决于平台)
+ */
+static inline void wsclock_sleep_us(unsigned int us)
+{
+#ifdef _WIN32
+    Sleep(us < 1000 ? 1 : us / 1000);
+#else
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (long)(us % 1000000) * 1000L;
+    nanosleep(&ts, 0);
+#endif
+}
+
+#endif /* WSCLOCK_TIME_H */
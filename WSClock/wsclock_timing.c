@@ -0,0 +1,105 @@
+#include <stdlib.h>
+#include <string.h>
+#include "wsclock_timing.h"
+#include "wsclock_kernel.h"
+
+int wsclock_timing_init(WSClockTimingModel* model,
+                        const WSClockTimingConfig* config,
+                        int process_count)
+{
+    if (!model || !config || process_count <= 0) return -1;
+
+    memset(model, 0, sizeof(WSClockTimingModel));
+    model->config = *config;
+    if (model->config.queue_depth <= 0) {
+        model->config.queue_depth = 1;
+    }
+    model->process_count = process_count;
+    model->procs = (WSClockTimingProcess*)calloc((size_t)process_count, sizeof(WSClockTimingProcess));
+    model->slot_free_ns = (unsigned long long*)calloc((size_t)model->config.queue_depth,
+                                                      sizeof(unsigned long long));
+    if (!model->procs || !model->slot_free_ns) {
+        wsclock_timing_free(model);
+        return -1;
+    }
+    return 0;
+}
+
+void wsclock_timing_record(WSClockTimingModel* model, int process_index, int access_flags)
+{
+    if (!model || access_flags == WSCLOCK_ACCESS_INVALID) return;
+    if (process_index < 0 || process_index >= model->process_count) return;
+
+    WSClockTimingProcess* p = &model->procs[process_index];
+    p->refs++;
+    p->now_ns += model->config.hit_ns;
+
+    if (!(access_flags & WSCLOCK_ACCESS_FAULT)) {
+        return;
+    }
+
+    /* 缺页：脏页置换需先写回再读入，二者合并为一次设备请求；共享页的次缺页不需要读入 */
+    unsigned long long service = 0;
+    if (!(access_flags & WSCLOCK_ACCESS_MINOR)) {
+        service += model->config.fault_ns;
+        p->faults++;
+    }
+    if (access_flags & WSCLOCK_ACCESS_WRITEBACK) {
+        service += model->config.writeback_ns;
+        p->writebacks++;
+    }
+    if (service == 0) {
+        return;
+    }
+
+    /* 选择最早空闲的设备槽位；请求按模拟的提交顺序服务 */
+    int slot = 0;
+    for (int i = 1; i < model->config.queue_depth; i++) {
+        if (model->slot_free_ns[i] < model->slot_free_ns[slot]) {
+            slot = i;
+        }
+    }
+    unsigned long long start = model->slot_free_ns[slot] > p->now_ns
+                             ? model->slot_free_ns[slot] : p->now_ns;
+    unsigned long long finish = start + service;
+    model->slot_free_ns[slot] = finish;
+    model->device_busy_ns += service;
+
+    p->stall_ns += finish - p->now_ns;
+    p->now_ns = finish;
+}
+
+void wsclock_timing_report(const WSClockTimingModel* model, WSClockTimingReport* report)
+{
+    if (!model || !report) return;
+
+    memset(report, 0, sizeof(WSClockTimingReport));
+    for (int i = 0; i < model->process_count; i++) {
+        const WSClockTimingProcess* p = &model->procs[i];
+        report->refs += p->refs;
+        report->faults += p->faults;
+        report->writebacks += p->writebacks;
+        report->total_stall_ns += p->stall_ns;
+        if (p->now_ns > report->makespan_ns) {
+            report->makespan_ns = p->now_ns;
+        }
+    }
+    if (report->refs > 0) {
+        report->effective_access_ns =
+            ((double)report->refs * (double)model->config.hit_ns + (double)report->total_stall_ns)
+            / (double)report->refs;
+    }
+    if (report->makespan_ns > 0) {
+        report->device_utilization = (double)model->device_busy_ns
+            / ((double)report->makespan_ns * (double)model->config.queue_depth);
+    }
+}
+
+void wsclock_timing_free(WSClockTimingModel* model)
+{
+    if (!model) return;
+    free(model->procs);
+    free(model->slot_free_ns);
+    model->procs = 0;
+    model->slot_free_ns = 0;
+}
@@ -0,0 +1,87 @@
+#ifndef WSCLOCK_TIMING_H
+#define WSCLOCK_TIMING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 访问时延模型的配置(单位：纳秒)
+ */
+typedef struct WSClockTimingConfig {
+    unsigned long hit_ns;        /* 内存命中延迟 */
+    unsigned long fault_ns;      /* 缺页服务时间(从后备存储读入一页) */
+    unsigned long writeback_ns;  /* 脏页写回时间 */
+    int queue_depth;             /* 设备可同时处理的请求数 */
+} WSClockTimingConfig;
+
+/*
+ * 每个进程的时延统计
+ */
+typedef struct WSClockTimingProcess {
+    unsigned long long now_ns;      /* 进程自己的时间线 */
+    unsigned long long refs;        /* 访问次数 */
+    unsigned long long faults;      /* 缺页次数(需要读入的主缺页，不含共享页的次缺页) */
+    unsigned long long writebacks;  /* 写回次数 */
+    unsigned long long stall_ns;    /* 等待设备的总时间(含排队) */
+} WSClockTimingProcess;
+
+/*
+ * 时延模型：由模拟过程逐次驱动
+ *  - 每次访问先花费 hit_ns
+ *  - 缺页时向设备提交一个请求(脏页置换时还要先写回)，进程阻塞到请求完成
+ *  - 设备有 queue_depth 个服务槽，请求按提交顺序占用最早空闲的槽
+ */
+typedef struct WSClockTimingModel {
+    WSClockTimingConfig config;
+    int process_count;
+    WSClockTimingProcess* procs;
+    unsigned long long* slot_free_ns;   /* 每个设备槽位的空闲时刻 */
+    unsigned long long device_busy_ns;  /* 设备累计服务时间 */
+} WSClockTimingModel;
+
+/*
+ * 汇总结果
+ */
+typedef struct WSClockTimingReport {
+    unsigned long long refs;
+    unsigned long long faults;
+    unsigned long long writebacks;
+    unsigned long long makespan_ns;     /* 最慢进程的完成时刻 */
+    unsigned long long total_stall_ns;
+    double effective_access_ns;         /* 有效访问时间 = (命中时间 + 阻塞时间) / 访问次数 */
+    double device_utilization;          /* 设备利用率 = 服务时间 / (makespan * queue_depth) */
+} WSClockTimingReport;
+
+/*
+ * 初始化时延模型
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法或内存不足
+ */
+int wsclock_timing_init(WSClockTimingModel* model,
+                        const WSClockTimingConfig* config,
+                        int process_count);
+
+/*
+ * 记录一次访问
+ * 参数:
+ *   - access_flags: wsclock_access_page(_ex) 的返回值，WSCLOCK_ACCESS_INVALID 时忽略
+ */
+void wsclock_timing_record(WSClockTimingModel* model, int process_index, int access_flags);
+
+/*
+ * 计算汇总结果
+ */
+void wsclock_timing_report(const WSClockTimingModel* model, WSClockTimingReport* report);
+
+/*
+ * 释放时延模型
+ */
+void wsclock_timing_free(WSClockTimingModel* model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_TIMING_H */
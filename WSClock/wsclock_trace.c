@@ -0,0 +1,364 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "wsclock_trace.h"
+#include "wsclock_atomic.h"
+
+#define TRACE_HEADER_BYTES 40
+#define TRACE_INDEX_BYTES  16
+#define TRACE_MAX_VARINT   5     /* 32 位值的 varint 最多 5 字节 */
+
+static void put_u32(unsigned char* p, unsigned int v)
+{
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static void put_u64(unsigned char* p, unsigned long long v)
+{
+    put_u32(p, (unsigned int)v);
+    put_u32(p + 4, (unsigned int)(v >> 32));
+}
+
+static unsigned int get_u32(const unsigned char* p)
+{
+    return (unsigned int)p[0] | (unsigned int)p[1] << 8 | (unsigned int)p[2] << 16 | (unsigned int)p[3] << 24;
+}
+
+static unsigned long long get_u64(const unsigned char* p)
+{
+    return (unsigned long long)get_u32(p) | (unsigned long long)get_u32(p + 4) << 32;
+}
+
+static unsigned char* put_varint(unsigned char* p, unsigned int v)
+{
+    while (v >= 0x80) {
+        *p++ = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (unsigned char)v;
+    return p;
+}
+
+/* zigzag：把有符号差值映射为小的无符号数，0,-1,1,-2,... -> 0,1,2,3,... */
+static unsigned int zigzag(int d)
+{
+    return ((unsigned int)d << 1) ^ (unsigned int)(d >> 31);
+}
+
+static int unzigzag(unsigned int v)
+{
+    return (int)(v >> 1) ^ -(int)(v & 1);
+}
+
+/* 编码一块，返回写入的字节数；pid 越界时返回 0 */
+static size_t encode_block(unsigned char* out, const int* pages, const int* pids, long long first, int refs,
+                           int streams, int* prev)
+{
+    unsigned char* p = out;
+    int s = (int)(first % streams);
+    memset(prev, 0, sizeof(int) * (size_t)streams);
+    for (int i = 0; i < refs; i++) {
+        if (pids) {
+            s = pids[i];
+            if (s < 0 || s >= streams) return 0;
+            p = put_varint(p, (unsigned int)s);
+        }
+        /* 页号非负，差值落在 int 范围内 */
+        p = put_varint(p, zigzag(pages[i] - prev[s]));
+        prev[s] = pages[i];
+        if (!pids && ++s == streams) s = 0;
+    }
+    return (size_t)(p - out);
+}
+
+int wsclock_trace_write(const char* path, const int* pages, const int* pids, long long length,
+                        int streams, int block_refs, size_t* out_bytes)
+{
+    if (!path || !pages || length < 0 || streams <= 0 || streams > WSCLOCK_TRACE_MAX_STREAMS) return -1;
+    if (block_refs <= 0) block_refs = WSCLOCK_TRACE_BLOCK_REFS;
+    for (long long i = 0; i < length; i++) {
+        if (pages[i] < 0) return -1;
+    }
+
+    long long block_count = (length + block_refs - 1) / block_refs;
+    if (block_count > 0x7fffffffLL) return -1;
+    size_t index_bytes = TRACE_INDEX_BYTES * (size_t)block_count;
+    size_t per_ref = pids ? 2 * TRACE_MAX_VARINT : TRACE_MAX_VARINT;
+    unsigned char* head = (unsigned char*)malloc(TRACE_HEADER_BYTES + index_bytes);
+    unsigned char* buf = (unsigned char*)malloc(per_ref * (size_t)block_refs);
+    int* prev = (int*)malloc(sizeof(int) * (size_t)streams);
+    FILE* fp = (head && buf && prev) ? fopen(path, "wb") : NULL;
+    int ok = fp != NULL;
+
+    /* 先占住头部与索引的位置，数据写完后回填 */
+    if (ok) ok = fwrite(head, 1, TRACE_HEADER_BYTES + index_bytes, fp) == TRACE_HEADER_BYTES + index_bytes;
+    unsigned long long offset = 0;
+    for (long long b = 0; ok && b < block_count; b++) {
+        long long first = b * block_refs;
+        int refs = (int)(length - first < block_refs ? length - first : block_refs);
+        size_t bytes = encode_block(buf, pages + first, pids ? pids + first : NULL, first, refs, streams, prev);
+        ok = bytes > 0 && fwrite(buf, 1, bytes, fp) == bytes;
+        unsigned char* entry = head + TRACE_HEADER_BYTES + TRACE_INDEX_BYTES * (size_t)b;
+        put_u64(entry, offset);
+        put_u32(entry + 8, (unsigned int)bytes);
+        put_u32(entry + 12, (unsigned int)refs);
+        offset += bytes;
+    }
+    if (ok) {
+        put_u32(head, WSCLOCK_TRACE_MAGIC);
+        put_u32(head + 4, WSCLOCK_TRACE_VERSION);
+        put_u32(head + 8, pids ? WSCLOCK_TRACE_PIDS : 0);
+        put_u32(head + 12, (unsigned int)streams);
+        put_u32(head + 16, (unsigned int)block_refs);
+        put_u32(head + 20, (unsigned int)block_count);
+        put_u64(head + 24, (unsigned long long)length);
+        put_u64(head + 32, offset);
+        ok = fseek(fp, 0, SEEK_SET) == 0 &&
+             fwrite(head, 1, TRACE_HEADER_BYTES + index_bytes, fp) == TRACE_HEADER_BYTES + index_bytes;
+    }
+    if (fp && fclose(fp) != 0) ok = 0;
+    if (ok && out_bytes) *out_bytes = TRACE_HEADER_BYTES + index_bytes + (size_t)offset;
+    free(head);
+    free(buf);
+    free(prev);
+    return ok ? 0 : -1;
+}
+
+int wsclock_trace_is_compressed(const char* path)
+{
+    FILE* fp = path ? fopen(path, "rb") : NULL;
+    if (!fp) return 0;
+    unsigned char magic[4];
+    int yes = fread(magic, 1, 4, fp) == 4 && get_u32(magic) == WSCLOCK_TRACE_MAGIC;
+    fclose(fp);
+    return yes;
+}
+
+int wsclock_trace_open(WSClockTrace* trace, const char* path)
+{
+    if (!trace || !path) return -1;
+    memset(trace, 0, sizeof(WSClockTrace));
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return -1;
+    long size = -1;
+    if (fseek(fp, 0, SEEK_END) == 0) {
+        size = ftell(fp);
+        rewind(fp);
+    }
+    if (size < TRACE_HEADER_BYTES) {
+        fclose(fp);
+        return -1;
+    }
+    trace->file = (unsigned char*)malloc((size_t)size);
+    trace->file_size = (size_t)size;
+    int ok = trace->file && fread(trace->file, 1, (size_t)size, fp) == (size_t)size;
+    fclose(fp);
+
+    const unsigned char* h = trace->file;
+    if (ok) {
+        ok = get_u32(h) == WSCLOCK_TRACE_MAGIC && get_u32(h + 4) == WSCLOCK_TRACE_VERSION;
+    }
+    if (ok) {
+        trace->flags = (int)get_u32(h + 8);
+        unsigned int streams = get_u32(h + 12);
+        unsigned int block_refs = get_u32(h + 16);
+        unsigned int block_count = get_u32(h + 20);
+        unsigned long long total = get_u64(h + 24);
+        unsigned long long data_bytes = get_u64(h + 32);
+        size_t index_bytes = TRACE_INDEX_BYTES * (size_t)block_count;
+        ok = streams > 0 && streams <= WSCLOCK_TRACE_MAX_STREAMS &&
+             block_refs > 0 && block_refs <= 0x7fffffffu && block_count <= 0x7fffffffu &&
+             (total + block_refs - 1) / block_refs == block_count &&
+             (unsigned long long)TRACE_HEADER_BYTES + index_bytes + data_bytes == (unsigned long long)size;
+        if (ok) {
+            trace->streams = (int)streams;
+            trace->block_refs = (int)block_refs;
+            trace->block_count = (int)block_count;
+            trace->total_refs = (long long)total;
+            trace->data = trace->file + TRACE_HEADER_BYTES + index_bytes;
+            trace->index = (WSClockTraceBlock*)malloc(sizeof(WSClockTraceBlock) * (block_count ? block_count : 1));
+            ok = trace->index != NULL;
+        }
+        /* 索引：块首尾不越界，除最后一块外每块恰好 block_refs 条 */
+        for (unsigned int b = 0; ok && b < block_count; b++) {
+            const unsigned char* e = h + TRACE_HEADER_BYTES + TRACE_INDEX_BYTES * (size_t)b;
+            WSClockTraceBlock* blk = &trace->index[b];
+            blk->offset = get_u64(e);
+            blk->bytes = get_u32(e + 8);
+            blk->refs = get_u32(e + 12);
+            unsigned long long expect = b + 1 < block_count ? block_refs : total - (unsigned long long)b * block_refs;
+            ok = blk->refs == expect && blk->offset <= data_bytes && blk->bytes <= data_bytes - blk->offset;
+        }
+    }
+    if (!ok) {
+        wsclock_trace_close(trace);
+        return -1;
+    }
+    return 0;
+}
+
+/* 解码 [p, end) 中的一个 varint；越界或超过 32 位时返回 NULL */
+static inline const unsigned char* get_varint(const unsigned char* p, const unsigned char* end, unsigned int* v)
+{
+    if (p < end && *p < 0x80) {
+        *v = *p;
+        return p + 1;
+    }
+    unsigned int r = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (p >= end) return NULL;
+        unsigned int c = *p++;
+        r |= (c & 0x7f) << shift;
+        if (c < 0x80) {
+            *v = r;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+/* 解码块的前 limit 条 */
+static int decode_prefix(const WSClockTrace* trace, int block, int limit, int* pages, int* pids)
+{
+    if (!trace || block < 0 || block >= trace->block_count) return -1;
+    const WSClockTraceBlock* blk = &trace->index[block];
+    const unsigned char* p = trace->data + blk->offset;
+    const unsigned char* end = p + blk->bytes;
+    int refs = limit < (int)blk->refs ? limit : (int)blk->refs;
+    int streams = trace->streams;
+    int has_pids = trace->flags & WSCLOCK_TRACE_PIDS;
+
+    int local[64];
+    int* prev = streams <= 64 ? local : (int*)malloc(sizeof(int) * (size_t)streams);
+    if (!prev) return -1;
+    memset(prev, 0, sizeof(int) * (size_t)streams);
+
+    int s = (int)(((long long)block * trace->block_refs) % streams);
+    int i;
+    for (i = 0; i < refs; i++) {
+        unsigned int v;
+        if (has_pids) {
+            p = get_varint(p, end, &v);
+            if (!p || v >= (unsigned int)streams) break;
+            s = (int)v;
+        }
+        p = get_varint(p, end, &v);
+        if (!p) break;
+        long long page = (long long)prev[s] + unzigzag(v);
+        if (page < 0 || page > 0x7fffffffLL) break;
+        prev[s] = (int)page;
+        pages[i] = (int)page;
+        if (pids) pids[i] = s;
+        if (!has_pids && ++s == streams) s = 0;
+    }
+    if (prev != local) free(prev);
+    return i == refs ? refs : -1;
+}
+
+int wsclock_trace_decode_block(const WSClockTrace* trace, int block, int* pages, int* pids)
+{
+    if (!trace || !pages || block < 0 || block >= trace->block_count) return -1;
+    return decode_prefix(trace, block, trace->block_refs, pages, pids);
+}
+
+long long wsclock_trace_read(const WSClockTrace* trace, long long first, long long count, int* pages, int* pids)
+{
+    if (!trace || !pages || first < 0 || count < 0) return -1;
+    if (first >= trace->total_refs) return 0;
+    if (count > trace->total_refs - first) count = trace->total_refs - first;
+
+    /* 块内起点之前的引用也要解码(差分依赖前一条)，解到临时缓冲区 */
+    int* tmp_pages = (int*)malloc(sizeof(int) * (size_t)trace->block_refs);
+    int* tmp_pids = pids ? (int*)malloc(sizeof(int) * (size_t)trace->block_refs) : NULL;
+    if (!tmp_pages || (pids && !tmp_pids)) {
+        free(tmp_pages);
+        free(tmp_pids);
+        return -1;
+    }
+    long long done = 0;
+    while (done < count) {
+        long long at = first + done;
+        int block = (int)(at / trace->block_refs);
+        int skip = (int)(at % trace->block_refs);
+        int want = (int)(count - done < trace->block_refs - skip ? count - done : trace->block_refs - skip);
+        if (decode_prefix(trace, block, skip + want, tmp_pages, tmp_pids) < 0) {
+            done = -1;
+            break;
+        }
+        memcpy(pages + done, tmp_pages + skip, sizeof(int) * (size_t)want);
+        if (pids) memcpy(pids + done, tmp_pids + skip, sizeof(int) * (size_t)want);
+        done += want;
+    }
+    free(tmp_pages);
+    free(tmp_pids);
+    return done;
+}
+
+/* 并行解码：各线程从 next 领取块号，块在输出中的位置由块号直接算出 */
+typedef struct TraceDecodeShared {
+    const WSClockTrace* trace;
+    int* pages;
+    int* pids;
+    int next;
+    int failed;
+} TraceDecodeShared;
+
+static void* trace_decode_main(void* arg)
+{
+    TraceDecodeShared* sh = (TraceDecodeShared*)arg;
+    for (;;) {
+        int b = WS_ATOMIC_FETCH_ADD(&sh->next, 1);
+        if (b >= sh->trace->block_count) break;
+        size_t at = (size_t)b * (size_t)sh->trace->block_refs;
+        if (wsclock_trace_decode_block(sh->trace, b, sh->pages + at, sh->pids ? sh->pids + at : NULL) < 0) {
+            WS_ATOMIC_STORE(&sh->failed, 1);
+        }
+    }
+    return 0;
+}
+
+int wsclock_trace_decode_all(const WSClockTrace* trace, int* pages, int* pids, int threads)
+{
+    if (!trace || !pages) return -1;
+    if (threads > trace->block_count) threads = trace->block_count;
+    if (threads < 1) threads = 1;
+
+    TraceDecodeShared sh;
+    sh.trace = trace;
+    sh.pages = pages;
+    sh.pids = pids;
+    sh.next = 0;
+    sh.failed = 0;
+    if (threads == 1) {
+        trace_decode_main(&sh);
+        return sh.failed ? -1 : 0;
+    }
+
+    pthread_t* tids = (pthread_t*)malloc(sizeof(pthread_t) * (size_t)threads);
+    if (!tids) return -1;
+    int started = 0;
+    for (int t = 0; t < threads; t++) {
+        if (pthread_create(&tids[t], 0, trace_decode_main, &sh) != 0) break;
+        started++;
+    }
+    /* 线程没能全部启动时由当前线程补上，剩下的块照样会被领完 */
+    if (started < threads) trace_decode_main(&sh);
+    for (int t = 0; t < started; t++) {
+        pthread_join(tids[t], 0);
+    }
+    free(tids);
+    return sh.failed ? -1 : 0;
+}
+
+void wsclock_trace_close(WSClockTrace* trace)
+{
+    if (!trace) return;
+    free(trace->index);
+    free(trace->file);
+    memset(trace, 0, sizeof(WSClockTrace));
+}
@@ -0,0 +1,105 @@
+#ifndef WSCLOCK_TRACE_H
+#define WSCLOCK_TRACE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 压缩引用序列格式(.wsct)，所有整数按小端序存放：
+ *  - 头部 40 字节: uint32 magic, version, flags, streams, block_refs, block_count;
+ *    uint64 total_refs, data_bytes
+ *  - 块索引: 每块 uint64 offset(相对数据区起点), uint32 bytes, uint32 refs
+ *  - 数据区: 各块依次存放
+ *
+ * 每条引用按所属流对上一条同流引用的页号做差分，差值经 zigzag 变换后按 varint 存放
+ * (7 位一组，最高位表示后面还有字节)。流的划分:
+ *  - 没有 WSCLOCK_TRACE_PIDS 时第 i 条引用属于流 i % streams(模拟器按轮转方式把序列分给各进程)
+ *  - 有 WSCLOCK_TRACE_PIDS 时每条引用先存进程号(varint)，流就是进程号，streams 为进程号上界
+ * 每个块开头各流的上一页号都从0开始，所以块可以独立解码；除最后一块外每块都是 block_refs 条，
+ * 第 n 条引用位于第 n / block_refs 块，定位不需要查找
+ */
+#define WSCLOCK_TRACE_MAGIC       0x54435357u  /* "WSCT" */
+#define WSCLOCK_TRACE_VERSION     1
+#define WSCLOCK_TRACE_PIDS        0x1
+#define WSCLOCK_TRACE_BLOCK_REFS  65536        /* 默认每块引用数 */
+#define WSCLOCK_TRACE_MAX_STREAMS 65536
+
+typedef struct WSClockTraceBlock {
+    unsigned long long offset;
+    unsigned int bytes;
+    unsigned int refs;
+} WSClockTraceBlock;
+
+/*
+ * 已打开的压缩序列：整个文件一次读入内存，解码时只读，可被多个线程同时使用
+ */
+typedef struct WSClockTrace {
+    int flags;
+    int streams;
+    int block_refs;
+    int block_count;
+    long long total_refs;
+    WSClockTraceBlock* index;
+    const unsigned char* data;     /* 数据区起点 */
+    unsigned char* file;           /* 整个文件的缓冲区 */
+    size_t file_size;
+} WSClockTrace;
+
+/*
+ * 编码并写入文件
+ * 参数:
+ *   - pages: 页号序列(不能为负)
+ *   - pids: 每条引用的进程号，可为NULL(此时按 streams 轮转划分)
+ *   - streams: 流数；pids 非NULL时必须大于所有进程号
+ *   - block_refs: 每块引用数，0 表示 WSCLOCK_TRACE_BLOCK_REFS
+ *   - out_bytes: 可为NULL，返回写入的文件大小
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数非法、内存不足或写入失败
+ */
+int wsclock_trace_write(const char* path, const int* pages, const int* pids, long long length,
+                        int streams, int block_refs, size_t* out_bytes);
+
+/*
+ * 判断文件是否为压缩序列(只检查 magic)
+ */
+int wsclock_trace_is_compressed(const char* path);
+
+/*
+ * 打开压缩序列：读入整个文件并校验头部与块索引
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 文件无法读取或格式不正确
+ */
+int wsclock_trace_open(WSClockTrace* trace, const char* path);
+
+/*
+ * 解码第 block 块，写入 pages[0..refs) 与 pids(可为NULL；没有 WSCLOCK_TRACE_PIDS 时填流号)
+ * 返回值: 该块的引用数；块号非法或数据损坏时为 -1
+ */
+int wsclock_trace_decode_block(const WSClockTrace* trace, int block, int* pages, int* pids);
+
+/*
+ * 从第 first 条引用开始解码 count 条(跳到所在的块，从块首解码到目标位置)
+ * 返回值: 实际解码的条数(到序列末尾为止)；出错时为 -1
+ */
+long long wsclock_trace_read(const WSClockTrace* trace, long long first, long long count, int* pages, int* pids);
+
+/*
+ * 用 threads 个线程并行解码整个序列(各线程从共享计数器领取块)，pages/pids 须能容纳 total_refs 条
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 线程创建失败或数据损坏
+ */
+int wsclock_trace_decode_all(const WSClockTrace* trace, int* pages, int* pids, int threads);
+
+void wsclock_trace_close(WSClockTrace* trace);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSCLOCK_TRACE_H */
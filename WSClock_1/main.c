@@ -61,6 +61,7 @@ int main()
         allProcs[i].working_set_size = 4;    /* 工作集容量3 */
         allProcs[i].clock = 0;
         allProcs[i].active = 1;             /* 激活状态 */
+        allProcs[i].clock_hand = 0;
         allProcs[i].page_table = (Page*)malloc(sizeof(Page)*allProcs[i].page_count);
 
         for(int j=0; j<allProcs[i].page_count; j++){
@@ -86,23 +86,22 @@ void wsclock_access_page(WSClockEnvironment* env,
  */
 static Page* find_victim_page(Process* proc)
 {
-    /* 需要一个指针记录当前扫描位置；可以在Process结构中加字段 clockHand */
-    static int clockHand = 0;  /* 为简化，这里使用静态变量模拟单个进程指针 */
+    /* 时钟指针保存在各自进程的 clock_hand 中，进程之间互不干扰 */
     int scanCount = 0;         /* 防止无限循环 */
     int writesThisRound = 0;   /* 跟踪本轮写回的次数 */
 
     int totalPages = proc->page_count;
-    if (clockHand >= totalPages) {
-        clockHand = 0;
+    if (proc->clock_hand >= totalPages) {
+        proc->clock_hand = 0;
     }
 
     while (scanCount < totalPages) {
-        Page* currentPage = &proc->page_table[clockHand];
+        Page* currentPage = &proc->page_table[proc->clock_hand];
         if (currentPage->in_working_set) {
             if (currentPage->referenced == 1) {
                 /* 最近使用过 => R=1 => 清零并跳过 */
                 currentPage->referenced = 0;
-                clockHand = (clockHand + 1) % totalPages;
+                proc->clock_hand = (proc->clock_hand + 1) % totalPages;
                 scanCount++;
                 continue;
             } else {
@@ -129,21 +128,21 @@ static Page* find_victim_page(Process* proc)
                             return currentPage;
                         } else {
                             /* 达到写回上限 => 暂不回收, 指针继续前移 */
-                            clockHand = (clockHand + 1) % totalPages;
+                            proc->clock_hand = (proc->clock_hand + 1) % totalPages;
                             scanCount++;
                             continue;
                         }
                     }
                 } else {
                     /* 没到老化时间 => 继续 */
-                    clockHand = (clockHand + 1) % totalPages;
+                    proc->clock_hand = (proc->clock_hand + 1) % totalPages;
                     scanCount++;
                     continue;
                 }
             }
         } else {
             /* 不在工作集 => 跳过 */
-            clockHand = (clockHand + 1) % totalPages;
+            proc->clock_hand = (proc->clock_hand + 1) % totalPages;
             scanCount++;
             continue;
         }
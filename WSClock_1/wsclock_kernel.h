@@ -31,6 +31,7 @@ typedef struct Process {
     int working_set_size; /* 工作集容量限制 */
     unsigned long clock;  /* 模拟进程内(或全局)时钟 */
     int active;           /* 是否处于可调度状态(模拟多进程管理) */
+    int clock_hand;       /* WSClock 时钟指针：下一次置换从该页开始扫描 */
 } Process;
 
 /*
@@ -4,22 +4,304 @@
 static ProcessControlBlock g_processTable[MAX_PROCESSES];
 static int g_processCount = 0;
 
+/* 全局共享页表与共享段 */
+typedef struct {
+    int segmentId;
+    int first;
+    int pageCount;
+} SharedSegment;
+
+static SharedPageInfo g_sharedPages[MAX_SHARED_PAGES];
+static int g_sharedPageCount = 0;
+static SharedSegment g_sharedSegments[MAX_SHARED_SEGMENTS];
+static int g_sharedSegmentCount = 0;
+
+/*
+ * 页表池(伙伴分配)：池按最大块大小划分，分配时从最小的够用的空闲块对半拆分，
+ * 释放时若伙伴块(下标异或块大小)也空闲就合并，避免小块把池切碎。
+ * 空闲块按大小级别串成双向链表：块首项的 pageId 存“下一块”、sharedIndex 存“上一块”(池下标，-1 为空)；
+ * g_pageFreeClass[i] 为以 i 开头的空闲块的级别，不是空闲块开头时为 -1
+ */
+static PageInfo g_pagePool[KERNEL_PAGE_POOL_SIZE];
+static signed char g_pageFreeClass[KERNEL_PAGE_POOL_SIZE];
+static int g_pageFreeHead[KERNEL_PAGE_CLASSES];
+static int g_pagePoolUsed = 0;
+static int g_pageFreeBlocks = 0;
+
+/*
+ * 写时复制：g_pageRefs[i] 为以 i 开头的已分配块被多少个进程共享(fork 后 >1)，
+ * 共享的块只读，进程第一次修改页表时复制一份(见 WritablePages)
+ */
+static int g_pageRefs[KERNEL_PAGE_POOL_SIZE];
+static int g_cowCopies = 0;
+
+static void PagePoolPush(int at, int c)
+{
+    g_pagePool[at].pageId = g_pageFreeHead[c];
+    g_pagePool[at].sharedIndex = -1;
+    if (g_pageFreeHead[c] >= 0) {
+        g_pagePool[g_pageFreeHead[c]].sharedIndex = at;
+    }
+    g_pageFreeHead[c] = at;
+    g_pageFreeClass[at] = (signed char)c;
+    g_pageFreeBlocks++;
+}
+
+static void PagePoolRemove(int at, int c)
+{
+    int next = g_pagePool[at].pageId;
+    int prev = g_pagePool[at].sharedIndex;
+    if (prev >= 0) {
+        g_pagePool[prev].pageId = next;
+    } else {
+        g_pageFreeHead[c] = next;
+    }
+    if (next >= 0) {
+        g_pagePool[next].sharedIndex = prev;
+    }
+    g_pageFreeClass[at] = -1;
+    g_pageFreeBlocks--;
+}
+
+static void PagePoolReset(void)
+{
+    int c, i, top = KERNEL_PAGE_CLASSES - 1;
+    g_pagePoolUsed = 0;
+    g_pageFreeBlocks = 0;
+    g_cowCopies = 0;
+    for (c = 0; c < KERNEL_PAGE_CLASSES; c++) {
+        g_pageFreeHead[c] = -1;
+    }
+    for (i = 0; i < KERNEL_PAGE_POOL_SIZE; i++) {
+        g_pageFreeClass[i] = -1;
+    }
+    /* 池尾不足一个最大块的部分不使用 */
+    for (i = (KERNEL_PAGE_POOL_SIZE >> top << top) - (1 << top); i >= 0; i -= 1 << top) {
+        PagePoolPush(i, top);
+    }
+}
+
+/* 分配能容纳 count 项的块，级别写入 *pageClass；没有足够大的空闲块时返回0 */
+static PageInfo* PagePoolAlloc(int count, int *pageClass)
+{
+    int c = 0, k, at;
+
+    while ((1 << c) < count) {
+        c++;
+    }
+    for (k = c; k < KERNEL_PAGE_CLASSES && g_pageFreeHead[k] < 0; k++) {
+    }
+    if (k >= KERNEL_PAGE_CLASSES) {
+        return 0;
+    }
+    at = g_pageFreeHead[k];
+    PagePoolRemove(at, k);
+    while (k > c) {
+        /* 对半拆分，后一半放回空闲链表 */
+        k--;
+        PagePoolPush(at + (1 << k), k);
+    }
+    g_pagePoolUsed += 1 << c;
+    g_pageRefs[at] = 1;
+    *pageClass = c;
+    return &g_pagePool[at];
+}
+
+static void PagePoolFree(PageInfo *pages, int pageClass)
+{
+    int at = (int)(pages - g_pagePool);
+    int c = pageClass;
+    int buddy;
+
+    g_pagePoolUsed -= 1 << c;
+    while (c < KERNEL_PAGE_CLASSES - 1) {
+        buddy = at ^ (1 << c);
+        if (buddy >= KERNEL_PAGE_POOL_SIZE || g_pageFreeClass[buddy] != c) {
+            break;
+        }
+        PagePoolRemove(buddy, c);
+        if (buddy < at) {
+            at = buddy;
+        }
+        c++;
+    }
+    PagePoolPush(at, c);
+}
+
+/* 插桩：计数宏与时延直方图。模块只在单线程中调用，直方图不需要加锁 */
+#if KERNEL_STATS
+#define KERNEL_COUNT(field, v) ((field) += (v))
+static KernelStats g_stats;
+static KernelClockFn g_clock = 0;
+#else
+#define KERNEL_COUNT(field, v) ((void)0)
+#endif
+
+static void ClearCounters(KernelCounters *c)
+{
+    c->references = 0;
+    c->faults = 0;
+    c->evictions = 0;
+    c->pagesScanned = 0;
+}
+
+/* 分桶下界 */
+static unsigned long HistBucketLow(int b)
+{
+    int sub = 1 << KERNEL_HIST_SUB_BITS;
+    int e;
+    if (b < sub) {
+        return (unsigned long)b;
+    }
+    e = b / sub + KERNEL_HIST_SUB_BITS - 1;
+    return (unsigned long)(sub + b % sub) << (e - KERNEL_HIST_SUB_BITS);
+}
+
+unsigned long Kernel_HistogramPercentile(const KernelHistogram* hist, int permille)
+{
+    unsigned long rank, seen = 0, v;
+    int b;
+
+    if (!hist || hist->count == 0) {
+        return 0;
+    }
+    if (permille >= 1000) {
+        return hist->max;
+    }
+    rank = hist->count / 1000 * (unsigned long)permille
+         + hist->count % 1000 * (unsigned long)permille / 1000;
+    for (b = 0; b < KERNEL_HIST_BUCKETS; b++) {
+        seen += hist->buckets[b];
+        if (seen > rank) {
+            /* 取桶的中点，限制在实际最小/最大值之间 */
+            v = b + 1 < KERNEL_HIST_BUCKETS
+              ? HistBucketLow(b) + (HistBucketLow(b + 1) - HistBucketLow(b)) / 2
+              : hist->max;
+            if (v < hist->min) v = hist->min;
+            if (v > hist->max) v = hist->max;
+            return v;
+        }
+    }
+    return hist->max;
+}
+
+#if KERNEL_STATS
+static void HistClear(KernelHistogram *h)
+{
+    int b;
+    h->count = 0;
+    h->sum = 0;
+    h->min = ~0UL;
+    h->max = 0;
+    for (b = 0; b < KERNEL_HIST_BUCKETS; b++) {
+        h->buckets[b] = 0;
+    }
+}
+
+static void HistRecord(KernelHistogram *h, unsigned long v)
+{
+    int e = 0, b;
+    if (v < (1UL << KERNEL_HIST_SUB_BITS)) {
+        b = (int)v;
+    } else {
+        while ((v >> e) > 1) {
+            e++;
+        }
+        b = (e - KERNEL_HIST_SUB_BITS + 1) * (1 << KERNEL_HIST_SUB_BITS)
+          + (int)((v >> (e - KERNEL_HIST_SUB_BITS)) & ((1UL << KERNEL_HIST_SUB_BITS) - 1));
+        if (b >= KERNEL_HIST_BUCKETS) {
+            b = KERNEL_HIST_BUCKETS - 1;
+        }
+    }
+    h->count++;
+    h->sum += v;
+    h->buckets[b]++;
+    if (v < h->min) h->min = v;
+    if (v > h->max) h->max = v;
+}
+#endif
+
+/*
+ * 修改页面的工作集标记，并维护共享页的引用计数
+ */
+static void SetInWorkingSet(PageInfo *page, int value)
+{
+    if (page->inWorkingSet == value) {
+        return;
+    }
+    page->inWorkingSet = value;
+    if (page->sharedIndex >= 0) {
+        g_sharedPages[page->sharedIndex].refCount += value ? 1 : -1;
+    }
+}
+
+static ProcessControlBlock* FindProcess(int processId)
+{
+    int i;
+    for (i = 0; i < MAX_PROCESSES; i++) {
+        if (g_processTable[i].ws.processId == processId) {
+            return &g_processTable[i];
+        }
+    }
+    return 0;
+}
+
+/*
+ * 取得进程可以修改的页表：页表块与其他进程共享时复制一份，原块引用计数减1。
+ * 页表池已满时返回0，此时页表保持不变
+ */
+static PageInfo* WritablePages(WorkingSet *ws)
+{
+    int at = (int)(ws->pages - g_pagePool);
+    int j, pageClass;
+    PageInfo *copy;
+
+    if (g_pageRefs[at] == 1) {
+        return ws->pages;
+    }
+    copy = PagePoolAlloc(ws->pageCount > 0 ? ws->pageCount : 1, &pageClass);
+    if (!copy) {
+        return 0;
+    }
+    for (j = 0; j < ws->pageCount; j++) {
+        copy[j] = ws->pages[j];
+    }
+    g_pageRefs[at]--;
+    g_cowCopies++;
+    ws->pages = copy;
+    ws->pageClass = pageClass;
+    return copy;
+}
+
+/* 释放进程对页表块的引用，最后一个引用者归还给页表池 */
+static void ReleasePages(WorkingSet *ws)
+{
+    int at = (int)(ws->pages - g_pagePool);
+    if (--g_pageRefs[at] == 0) {
+        PagePoolFree(ws->pages, ws->pageClass);
+    }
+    ws->pages = 0;
+}
+
 /* 
  * 内核初始化：
  *   - 清空进程表
  */
 void Kernel_Init(void)
 {
-    int i, j;
+    int i;
     g_processCount = 0;
+    g_sharedPageCount = 0;
+    g_sharedSegmentCount = 0;
+    PagePoolReset();
+    Kernel_ResetStats();
     for (i = 0; i < MAX_PROCESSES; i++) {
         g_processTable[i].ws.processId = -1;  /* 表示无效进程 */
         g_processTable[i].ws.pageCount = 0;
         g_processTable[i].ws.workingSetSize = 0;
-        for (j = 0; j < MAX_PAGES; j++) {
-            g_processTable[i].ws.pages[j].pageId = j;
-            g_processTable[i].ws.pages[j].inWorkingSet = 0;
-        }
+        g_processTable[i].ws.pages = 0;
+        g_processTable[i].ws.pageClass = 0;
+        ClearCounters(&g_processTable[i].ws.counters);
     }
 }
 
@@ -28,7 +310,8 @@ void Kernel_Init(void)
  */
 int Kernel_CreateProcess(int processId, int maxPages, int workingSetSize)
 {
-    int i, j;
+    int i, j, pageCount;
+    PageInfo *pages;
 
     if (g_processCount >= MAX_PROCESSES) {
         /* 达到最大进程数，无法再创建 */
@@ -38,14 +321,22 @@ int Kernel_CreateProcess(int processId, int maxPages, int workingSetSize)
     /* 找到一个空闲的进程槽 */
     for (i = 0; i < MAX_PROCESSES; i++) {
         if (g_processTable[i].ws.processId == -1) {
+            pageCount = (maxPages > MAX_PAGES) ? MAX_PAGES : (maxPages > 0 ? maxPages : 0);
+            pages = PagePoolAlloc(pageCount > 0 ? pageCount : 1, &g_processTable[i].ws.pageClass);
+            if (!pages) {
+                return -1; /* 页表池已满 */
+            }
+            g_processTable[i].ws.pages = pages;
             g_processTable[i].ws.processId = processId;
-            g_processTable[i].ws.pageCount = (maxPages > MAX_PAGES) ? MAX_PAGES : maxPages;
+            g_processTable[i].ws.pageCount = pageCount;
             g_processTable[i].ws.workingSetSize = workingSetSize > 0 ? workingSetSize : 1;
+            ClearCounters(&g_processTable[i].ws.counters);
             
             /* 将所有页初始设置为不在工作集里 */
             for (j = 0; j < g_processTable[i].ws.pageCount; j++) {
                 g_processTable[i].ws.pages[j].pageId = j;
                 g_processTable[i].ws.pages[j].inWorkingSet = 0;
+                g_processTable[i].ws.pages[j].sharedIndex = -1;
             }
 
             g_processCount++;
@@ -56,10 +347,109 @@ int Kernel_CreateProcess(int processId, int maxPages, int workingSetSize)
     return -1; /* 未找到空闲槽 */
 }
 
+/*
+ * 销毁进程：工作集中的共享页引用计数减1，再释放页表块的引用
+ * (页表块可能仍被 fork 出的进程共享，所以不修改页表项)
+ */
+int Kernel_DestroyProcess(int processId)
+{
+    int j;
+    ProcessControlBlock *pcb = FindProcess(processId);
+
+    if (!pcb || processId == -1) {
+        return -1;
+    }
+    for (j = 0; j < pcb->ws.pageCount; j++) {
+        if (pcb->ws.pages[j].inWorkingSet && pcb->ws.pages[j].sharedIndex >= 0) {
+            g_sharedPages[pcb->ws.pages[j].sharedIndex].refCount--;
+        }
+    }
+    ReleasePages(&pcb->ws);
+    pcb->ws.pageCount = 0;
+    pcb->ws.workingSetSize = 0;
+    pcb->ws.processId = -1;
+    g_processCount--;
+    return 0;
+}
+
+/*
+ * fork：子进程与父进程共享页表块，只增加块的引用计数；
+ * 子进程工作集中的共享页同样计入引用计数
+ */
+int Kernel_ForkProcess(int parentId, int childId)
+{
+    int i, j;
+    ProcessControlBlock *parent = FindProcess(parentId);
+    ProcessControlBlock *child = 0;
+
+    if (!parent || parentId == -1 || childId == -1 || FindProcess(childId) ||
+        g_processCount >= MAX_PROCESSES) {
+        return -1;
+    }
+    for (i = 0; i < MAX_PROCESSES; i++) {
+        if (g_processTable[i].ws.processId == -1) {
+            child = &g_processTable[i];
+            break;
+        }
+    }
+    if (!child) {
+        return -1;
+    }
+
+    child->ws.processId = childId;
+    child->ws.pageCount = parent->ws.pageCount;
+    child->ws.workingSetSize = parent->ws.workingSetSize;
+    child->ws.pages = parent->ws.pages;
+    child->ws.pageClass = parent->ws.pageClass;
+    ClearCounters(&child->ws.counters);
+    g_pageRefs[parent->ws.pages - g_pagePool]++;
+    for (j = 0; j < child->ws.pageCount; j++) {
+        if (child->ws.pages[j].inWorkingSet && child->ws.pages[j].sharedIndex >= 0) {
+            g_sharedPages[child->ws.pages[j].sharedIndex].refCount++;
+        }
+    }
+    g_processCount++;
+    return 0;
+}
+
+void Kernel_GetPagePoolStats(PagePoolStats* stats)
+{
+    int c, i, j;
+    PageInfo *pages;
+
+    if (!stats) {
+        return;
+    }
+    stats->capacity = KERNEL_PAGE_POOL_SIZE;
+    stats->used = g_pagePoolUsed;
+    stats->freeBlocks = g_pageFreeBlocks;
+    stats->sharedBlocks = 0;
+    for (i = 0; i < MAX_PROCESSES; i++) {
+        pages = g_processTable[i].ws.pages;
+        if (g_processTable[i].ws.processId == -1 || g_pageRefs[pages - g_pagePool] < 2) {
+            continue;
+        }
+        /* 共享同一块的进程只算一次：只在第一个引用者处计数 */
+        for (j = 0; j < i && !(g_processTable[j].ws.processId != -1 && g_processTable[j].ws.pages == pages); j++) {
+        }
+        if (j == i) {
+            stats->sharedBlocks++;
+        }
+    }
+    stats->cowCopies = g_cowCopies;
+    stats->largestFree = 0;
+    for (c = KERNEL_PAGE_CLASSES - 1; c >= 0; c--) {
+        if (g_pageFreeHead[c] >= 0) {
+            stats->largestFree = 1 << c;
+            break;
+        }
+    }
+}
+
 /*
  * 引用某个进程的某个页面，更新其在工作集中的标记
  */
-int Kernel_ReferencePage(int processId, int pageId)
+static int ReferencePage(int processId, int pageId)
 {
     int i;
     ProcessControlBlock *pcb = 0;
@@ -82,17 +472,38 @@ int Kernel_ReferencePage(int processId, int pageId)
         return -1;
     }
 
+    /* 页面已在工作集中时页表不变，不必打破写时复制 */
+    if (!pcb->ws.pages[pageId].inWorkingSet && !WritablePages(&pcb->ws)) {
+        return -1; /* 页表池已满，无法复制共享的页表 */
+    }
+
+    KERNEL_COUNT(pcb->ws.counters.references, 1);
+    KERNEL_COUNT(pcb->ws.counters.faults, pcb->ws.pages[pageId].inWorkingSet ? 0 : 1);
+
     /* 简单标记为引用，后续 Kernel_UpdateWorkingSets 决定其是否停留在工作集中 */
-    pcb->ws.pages[pageId].inWorkingSet = 1;
+    SetInWorkingSet(&pcb->ws.pages[pageId], 1);
 
     return 0;
 }
 
+int Kernel_ReferencePage(int processId, int pageId)
+{
+#if KERNEL_STATS
+    if (g_clock) {
+        unsigned long t0 = g_clock();
+        int ret = ReferencePage(processId, pageId);
+        HistRecord(&g_stats.ops[KERNEL_OP_REFERENCE], g_clock() - t0);
+        return ret;
+    }
+#endif
+    return ReferencePage(processId, pageId);
+}
+
 /*
  * 简单地更新工作集：若页面被引用则置1，若超过工作集大小则置0。
  * 这是演示性的算法，以固定大小的窗口 (workingSetSize) 来控制工作集中能保留多少“最新”引用。
  */
-void Kernel_UpdateWorkingSets(void)
+static void UpdateWorkingSets(void)
 {
     int i, j, count;
     ProcessControlBlock *pcb;
@@ -110,21 +521,200 @@ void Kernel_UpdateWorkingSets(void)
                 count++;
             }
         }
+        KERNEL_COUNT(pcb->ws.counters.pagesScanned, (unsigned long)pcb->ws.pageCount);
 
         /* 若页面数超过了工作集大小，则随机或按一定策略移除一些页面 */
         /* 这里仅展示一个示例策略：从头开始清除多余的页 */
-        if (count > pcb->ws.workingSetSize) {
+        /* 共享的页表先复制；页表池已满时本轮跳过该进程 */
+        if (count > pcb->ws.workingSetSize && WritablePages(&pcb->ws)) {
             int toRemove = count - pcb->ws.workingSetSize;
             for (j = 0; j < pcb->ws.pageCount && toRemove > 0; j++) {
                 if (pcb->ws.pages[j].inWorkingSet) {
-                    pcb->ws.pages[j].inWorkingSet = 0;
+                    SetInWorkingSet(&pcb->ws.pages[j], 0);
                     toRemove--;
+                    KERNEL_COUNT(pcb->ws.counters.evictions, 1);
                 }
             }
+            KERNEL_COUNT(pcb->ws.counters.pagesScanned, (unsigned long)j);
         }
     }
 }
 
+void Kernel_UpdateWorkingSets(void)
+{
+#if KERNEL_STATS
+    if (g_clock) {
+        unsigned long t0 = g_clock();
+        UpdateWorkingSets();
+        HistRecord(&g_stats.ops[KERNEL_OP_UPDATE], g_clock() - t0);
+        return;
+    }
+#endif
+    UpdateWorkingSets();
+}
+
+/*
+ * 创建共享段：在全局共享页表中分配连续的 pageCount 项
+ */
+int Kernel_CreateSharedSegment(int segmentId, int pageCount)
+{
+    int i;
+    SharedSegment *seg;
+
+    if (pageCount <= 0 || g_sharedSegmentCount >= MAX_SHARED_SEGMENTS ||
+        g_sharedPageCount + pageCount > MAX_SHARED_PAGES) {
+        return -1;
+    }
+    for (i = 0; i < g_sharedSegmentCount; i++) {
+        if (g_sharedSegments[i].segmentId == segmentId) {
+            return -1; /* 段号已存在 */
+        }
+    }
+
+    seg = &g_sharedSegments[g_sharedSegmentCount++];
+    seg->segmentId = segmentId;
+    seg->first = g_sharedPageCount;
+    seg->pageCount = pageCount;
+    for (i = 0; i < pageCount; i++) {
+        g_sharedPages[g_sharedPageCount].segmentId = segmentId;
+        g_sharedPages[g_sharedPageCount].pageIndex = i;
+        g_sharedPages[g_sharedPageCount].refCount = 0;
+        g_sharedPageCount++;
+    }
+    return 0;
+}
+
+/*
+ * 建立进程页面到共享页的映射
+ */
+int Kernel_MapSharedSegment(int processId, int firstPage, int segmentId, int segmentOffset, int count)
+{
+    int i;
+    SharedSegment *seg = 0;
+    ProcessControlBlock *pcb = FindProcess(processId);
+
+    if (!pcb || count <= 0 || firstPage < 0 || segmentOffset < 0 ||
+        firstPage + count > pcb->ws.pageCount) {
+        return -1;
+    }
+    for (i = 0; i < g_sharedSegmentCount; i++) {
+        if (g_sharedSegments[i].segmentId == segmentId) {
+            seg = &g_sharedSegments[i];
+            break;
+        }
+    }
+    if (!seg || segmentOffset + count > seg->pageCount || !WritablePages(&pcb->ws)) {
+        return -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        PageInfo *page = &pcb->ws.pages[firstPage + i];
+        int inWs = page->inWorkingSet;
+        /* 先按旧映射移出再按新映射加入，保持引用计数一致 */
+        SetInWorkingSet(page, 0);
+        page->sharedIndex = seg->first + segmentOffset + i;
+        SetInWorkingSet(page, inWs);
+    }
+    return 0;
+}
+
+/*
+ * 统计进程的 RSS/PSS/USS
+ */
+int Kernel_GetMemoryUsage(int processId, MemoryUsage* usage)
+{
+    int j, refs;
+    ProcessControlBlock *pcb = FindProcess(processId);
+
+    if (!pcb || !usage) {
+        return -1;
+    }
+    usage->rss = 0;
+    usage->sharedPages = 0;
+    usage->pssScaled = 0;
+    usage->uss = 0;
+    for (j = 0; j < pcb->ws.pageCount; j++) {
+        PageInfo *page = &pcb->ws.pages[j];
+        if (!page->inWorkingSet) {
+            continue;
+        }
+        usage->rss++;
+        refs = 1;
+        if (page->sharedIndex >= 0) {
+            usage->sharedPages++;
+            refs = g_sharedPages[page->sharedIndex].refCount;
+            if (refs < 1) {
+                refs = 1;
+            }
+        }
+        usage->pssScaled += (1L << KERNEL_PSS_SHIFT) / refs;
+        if (refs == 1) {
+            usage->uss++;
+        }
+    }
+    return 0;
+}
+
+/* 实际占用的物理页框数 */
+int Kernel_GetResidentFrames(void)
+{
+    int i, j, frames = 0;
+
+    for (i = 0; i < MAX_PROCESSES; i++) {
+        if (g_processTable[i].ws.processId == -1) {
+            continue;
+        }
+        for (j = 0; j < g_processTable[i].ws.pageCount; j++) {
+            if (g_processTable[i].ws.pages[j].inWorkingSet &&
+                g_processTable[i].ws.pages[j].sharedIndex < 0) {
+                frames++;
+            }
+        }
+    }
+    for (i = 0; i < g_sharedPageCount; i++) {
+        if (g_sharedPages[i].refCount > 0) {
+            frames++;
+        }
+    }
+    return frames;
+}
+
+void Kernel_SetClock(KernelClockFn clock)
+{
+#if KERNEL_STATS
+    g_clock = clock;
+#else
+    (void)clock;
+#endif
+}
+
+int Kernel_GetStats(KernelStats* stats)
+{
+#if KERNEL_STATS
+    if (!stats) {
+        return -1;
+    }
+    *stats = g_stats;
+    return 0;
+#else
+    (void)stats;
+    return -1;
+#endif
+}
+
+void Kernel_ResetStats(void)
+{
+    int i;
+#if KERNEL_STATS
+    for (i = 0; i < KERNEL_OP_COUNT; i++) {
+        HistClear(&g_stats.ops[i]);
+    }
+#endif
+    for (i = 0; i < MAX_PROCESSES; i++) {
+        ClearCounters(&g_processTable[i].ws.counters);
+    }
+}
+
 /* 获取进程表首地址 */
 ProcessControlBlock* Kernel_GetProcessTable(void)
 {
@@ -15,28 +15,140 @@ extern "C" {
 #define MAX_PROCESSES 10   /* 最大支持的进程数 */
 #define MAX_PAGES     256  /* 单个进程可用最大页数 */
 
+/*
+ * 页表池：所有进程的页表从同一个静态池中按 2 的幂大小(伙伴算法)分块分配，
+ * 销毁进程时归还并与空闲的伙伴块合并；创建/销毁的开销只与级别数有关，与进程数、页数无关。
+ * 默认容量与原先每个 PCB 内嵌 MAX_PAGES 项的总量相同，可在编译时调整(应为 MAX_PAGES 的倍数)
+ */
+#ifndef KERNEL_PAGE_POOL_SIZE
+#define KERNEL_PAGE_POOL_SIZE (MAX_PROCESSES * MAX_PAGES)
+#endif
+#define KERNEL_PAGE_CLASSES   9    /* 块大小 1,2,4,...,256 (须覆盖 MAX_PAGES) */
+#define MAX_SHARED_SEGMENTS 16    /* 最大共享段数 */
+#define MAX_SHARED_PAGES    1024  /* 所有共享段的总页数上限 */
+#define KERNEL_PSS_SHIFT    12    /* PSS 以 1/(1<<KERNEL_PSS_SHIFT) 页为单位的定点数表示 */
+
+/*
+ * 插桩编译开关：默认打开，编译时加 -DKERNEL_STATS=0 去掉计数与计时代码，
+ * 此时 Kernel_GetStats 返回 -1
+ */
+#ifndef KERNEL_STATS
+#define KERNEL_STATS 1
+#endif
+
+/*
+ * 接口时延直方图：对数-线性分桶，小于8的值各占一桶，之后每个2的幂区间等分为8个子桶
+ */
+#define KERNEL_HIST_SUB_BITS 3
+#define KERNEL_HIST_BUCKETS  256
+#define KERNEL_OP_REFERENCE  0    /* Kernel_ReferencePage */
+#define KERNEL_OP_UPDATE     1    /* Kernel_UpdateWorkingSets */
+#define KERNEL_OP_COUNT      2
+
 /*
  * 描述单个页面的信息
  *  - pageId: 页编号
  *  - inWorkingSet: 是否在工作集中
+ *  - sharedIndex: 映射到的全局共享页下标，-1 表示私有页
  */
 typedef struct {
     int pageId;
     int inWorkingSet;
+    int sharedIndex;
 } PageInfo;
 
+/*
+ * 页表池使用情况(单位：页表项)
+ *  - used: 分给进程的块的总大小(按块大小计)
+ *  - freeBlocks: 各空闲链表上的块数之和
+ *  - largestFree: 最大空闲块的大小，即此刻能创建的进程的最大页数
+ */
+typedef struct {
+    int capacity;
+    int used;
+    int freeBlocks;
+    int largestFree;
+    int sharedBlocks;   /* 被 fork 出的多个进程共享的块数 */
+    int cowCopies;      /* 写时复制累计复制的块数 */
+} PagePoolStats;
+
+/*
+ * 全局共享页(共享库代码、共享内存等)，由(段号, 段内页号)唯一确定
+ *  - refCount: 工作集中包含该页的进程数，>0 即驻留内存
+ */
+typedef struct {
+    int segmentId;
+    int pageIndex;
+    int refCount;
+} SharedPageInfo;
+
+/*
+ * 进程内存统计(单位：页)
+ *  - rss: 工作集中的页数
+ *  - sharedPages: rss 中的共享页数
+ *  - pssScaled: 按比例分摊的页数(共享页按 1/refCount 计)，左移 KERNEL_PSS_SHIFT 位的定点数
+ *  - uss: 只属于本进程的页数
+ */
+typedef struct {
+    int rss;
+    int sharedPages;
+    long pssScaled;
+    int uss;
+} MemoryUsage;
+
+/*
+ * 进程计数器
+ *  - references: 成功的页面引用次数
+ *  - faults: 引用时页面不在工作集中的次数
+ *  - evictions: 被 Kernel_UpdateWorkingSets 移出工作集的页数
+ *  - pagesScanned: Kernel_UpdateWorkingSets 检查过的页数(计数与移除两遍都算)
+ */
+typedef struct {
+    unsigned long references;
+    unsigned long faults;
+    unsigned long evictions;
+    unsigned long pagesScanned;
+} KernelCounters;
+
+/*
+ * 时延直方图，单位为时钟回调返回值的单位
+ */
+typedef struct {
+    unsigned long count;
+    unsigned long sum;
+    unsigned long min;
+    unsigned long max;
+    unsigned long buckets[KERNEL_HIST_BUCKETS];
+} KernelHistogram;
+
+/*
+ * 统计快照
+ *  - ops[]: 按 KERNEL_OP_* 索引的时延直方图(未设置时钟时为空)
+ */
+typedef struct {
+    KernelHistogram ops[KERNEL_OP_COUNT];
+} KernelStats;
+
+/*
+ * 计时用的时钟回调，由调用方提供(模块本身不依赖任何库)，返回单调递增的时间
+ */
+typedef unsigned long (*KernelClockFn)(void);
+
 /*
  * 工作集数据结构
  *  - processId: 进程ID
  *  - pageCount: 当前在使用的页总数
  *  - workingSetSize: 工作集可容纳的最大页数(可根据算法动态调整或设为固定)
- *  - pages[]: 存储此进程所有页面的在工作集中的状态
+ *  - pages: 存储此进程所有页面的在工作集中的状态，指向页表池中的一块(无效进程为0)
+ *  - pageClass: 该块的大小级别(块大小为 1<<pageClass)
  */
 typedef struct {
     int processId;
     int pageCount;
     int workingSetSize;
-    PageInfo pages[MAX_PAGES];
+    KernelCounters counters;
+    PageInfo *pages;
+    int pageClass;
 } WorkingSet;
 
 /*
@@ -55,17 +167,40 @@ typedef struct {
 void Kernel_Init(void);
 
 /*
- * 创建一个新进程，分配进程控制块并初始化其工作集。
+ * 创建一个新进程，分配进程控制块并初始化其工作集，页表从页表池分配。
  * 参数:
  *   - processId: 进程ID
  *   - maxPages: 此进程使用的最大页数
  *   - workingSetSize: 该进程的工作集大小
  * 返回值:
  *   - 0: 成功
- *   - -1: 失败(例如进程过多)
+ *   - -1: 失败(例如进程过多或页表池已满)
  */
 int Kernel_CreateProcess(int processId, int maxPages, int workingSetSize);
 
+/*
+ * 销毁进程：页表块归还页表池，进程槽可再次用于 Kernel_CreateProcess
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 进程不存在
+ */
+int Kernel_DestroyProcess(int processId);
+
+/*
+ * fork：创建进程 childId，继承父进程的页数、工作集大小与当前工作集(计数器从0开始)。
+ * 页表块写时复制：fork 只增加块的引用计数，任一方第一次修改页表时才复制整块
+ * (单个进程的页表不超过 MAX_PAGES 项，整块就是复制的最小单位)
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 父进程不存在、childId 已存在或进程过多
+ */
+int Kernel_ForkProcess(int parentId, int childId);
+
+/*
+ * 获取页表池的使用情况
+ */
+void Kernel_GetPagePoolStats(PagePoolStats* stats);
+
 /*
  * 根据“页面引用”更新工作集。
  * 参数:
@@ -73,7 +208,7 @@ int Kernel_CreateProcess(int processId, int maxPages, int workingSetSize);
  *   - pageId: 引用的页面
  * 返回值:
  *   - 0: 成功
- *   - -1: 对应进程或页面不存在
+ *   - -1: 对应进程或页面不存在，或页表需要写时复制而页表池已满
  */
 int Kernel_ReferencePage(int processId, int pageId);
 
@@ -83,6 +218,59 @@ int Kernel_ReferencePage(int processId, int pageId);
  */
 void Kernel_UpdateWorkingSets(void);
 
+/*
+ * 创建共享段
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 段号已存在、段数或总页数超出上限
+ */
+int Kernel_CreateSharedSegment(int segmentId, int pageCount);
+
+/*
+ * 把进程的 [firstPage, firstPage+count) 映射到共享段 segmentId 的 [segmentOffset, ...)
+ * 已在工作集中的页面会同步更新共享页的引用计数
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 进程或段不存在、范围越界，或页表需要写时复制而页表池已满
+ */
+int Kernel_MapSharedSegment(int processId, int firstPage, int segmentId, int segmentOffset, int count);
+
+/*
+ * 计算进程的 RSS/PSS/USS
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 进程不存在
+ */
+int Kernel_GetMemoryUsage(int processId, MemoryUsage* usage);
+
+/*
+ * 实际占用的物理页框数：私有驻留页 + 引用计数>0 的共享页(每个共享页只算一次)
+ */
+int Kernel_GetResidentFrames(void);
+
+/*
+ * 设置计时时钟，传 0 关闭计时(计数器不受影响)
+ */
+void Kernel_SetClock(KernelClockFn clock);
+
+/*
+ * 复制一份时延直方图快照
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 参数为空或插桩未编译
+ */
+int Kernel_GetStats(KernelStats* stats);
+
+/*
+ * 直方图分位数(p 以千分比给出，如 990 表示 p99)，返回值单位同时钟
+ */
+unsigned long Kernel_HistogramPercentile(const KernelHistogram* hist, int permille);
+
+/*
+ * 清空所有计数器与直方图
+ */
+void Kernel_ResetStats(void);
+
 /*
  * 获取内核中的进程控制块，用于演示读取状态。
  * 返回值:
@@ -92,6 +280,8 @@ ProcessControlBlock* Kernel_GetProcessTable(void);
 
 /*
  * 获取当前有效进程数量
+ * (进程表可能是稀疏的：Kernel_DestroyProcess 留下的空槽 processId 为 -1，
+ *  遍历进程表应检查全部 MAX_PROCESSES 个槽位，而不是前 count 个)
  */
 int Kernel_GetProcessCount(void);
 
@@ -1,5 +1,14 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L  /* clock_gettime */
+#endif
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 #include "kernel_module.h"
 
 /* 
@@ -8,20 +17,148 @@
  *  - 调用 kernel_module 提供的API 执行工作集相关操作
  */
 
+/*
+ * 提供给内核模块的计时时钟(纳秒)：单调时钟，只用于计算时间差
+ * (Windows 下为 QueryPerformanceCounter，其他平台为 clock_gettime(CLOCK_MONOTONIC))
+ */
+static unsigned long DemoClockNs(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (freq.QuadPart == 0) {
+        QueryPerformanceFrequency(&freq);
+    }
+    QueryPerformanceCounter(&now);
+    return (unsigned long)((now.QuadPart / freq.QuadPart) * 1000000000
+                           + (now.QuadPart % freq.QuadPart) * 1000000000 / freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long)ts.tv_sec * 1000000000UL + (unsigned long)ts.tv_nsec;
+#endif
+}
+
+/* 输出各进程计数器与接口时延分布 */
+static void PrintStats(void)
+{
+    static const char *opNames[KERNEL_OP_COUNT] = { "reference", "update" };
+    ProcessControlBlock *table = Kernel_GetProcessTable();
+    KernelStats stats;
+    int i;
+
+    if (Kernel_GetStats(&stats) != 0) {
+        printf("插桩未编译(KERNEL_STATS=0)\n");
+        return;
+    }
+    printf("插桩统计：\n");
+    for (i = 0; i < MAX_PROCESSES; i++) {
+        KernelCounters *c = &table[i].ws.counters;
+        if (table[i].ws.processId == -1) {
+            continue;
+        }
+        printf("  进程 %d: 引用 %lu, 缺页 %lu, 移出 %lu, 扫描 %lu 页\n",
+               table[i].ws.processId, c->references, c->faults, c->evictions, c->pagesScanned);
+    }
+    printf("  各接口时延(ns):\n");
+    printf("  %-10s %8s %8s %8s %8s %8s %8s\n", "op", "count", "mean", "p50", "p90", "p99", "max");
+    for (i = 0; i < KERNEL_OP_COUNT; i++) {
+        const KernelHistogram *h = &stats.ops[i];
+        if (h->count == 0) {
+            continue;
+        }
+        printf("  %-10s %8lu %8lu %8lu %8lu %8lu %8lu\n", opNames[i], h->count, h->sum / h->count,
+               Kernel_HistogramPercentile(h, 500), Kernel_HistogramPercentile(h, 900),
+               Kernel_HistogramPercentile(h, 990), h->max);
+    }
+    printf("\n");
+}
+
+/*
+ * fork 演示：子进程与父进程共享页表块，直到某一方第一次修改页表
+ */
+static void DemoFork(int parentId, int childId)
+{
+    PagePoolStats before, after;
+    ProcessControlBlock *table = Kernel_GetProcessTable();
+    int i, j, pageId = -1;
+
+    Kernel_GetPagePoolStats(&before);
+    if (Kernel_ForkProcess(parentId, childId) != 0) {
+        printf("fork 失败：父进程不存在或进程数已满\n\n");
+        return;
+    }
+    Kernel_GetPagePoolStats(&after);
+    printf("fork 演示：进程 %d -> 子进程 %d\n", parentId, childId);
+    printf("  fork 后页表池已用 %d -> %d 项, 共享块 %d\n", before.used, after.used, after.sharedBlocks);
+
+    /* 子进程引用一个不在工作集中的页面，触发页表复制 */
+    for (i = 0; i < MAX_PROCESSES; i++) {
+        if (table[i].ws.processId != childId) {
+            continue;
+        }
+        for (j = 0; j < table[i].ws.pageCount && pageId < 0; j++) {
+            if (!table[i].ws.pages[j].inWorkingSet) {
+                pageId = j;
+            }
+        }
+    }
+    if (pageId >= 0 && Kernel_ReferencePage(childId, pageId) == 0) {
+        Kernel_GetPagePoolStats(&after);
+        printf("  子进程引用页 %d 后页表池已用 %d 项, 共享块 %d, 累计复制 %d 块\n",
+               pageId, after.used, after.sharedBlocks, after.cowCopies);
+    }
+    Kernel_DestroyProcess(childId);
+    Kernel_GetPagePoolStats(&after);
+    printf("  子进程退出后页表池已用 %d 项\n\n", after.used);
+}
+
 int main(int argc, char* argv[])
 {
     FILE *fp = NULL;
     int processId, pageId;
     int i, j;
+    int sharedPages = 0;
+    int showStats = 0;
+    int showFork = 0;
+
+    /* 末尾的 -P 输出插桩统计，-F 演示 fork 的写时复制 */
+    while (argc > 1 && (strcmp(argv[argc - 1], "-P") == 0 || strcmp(argv[argc - 1], "-F") == 0)) {
+        if (argv[argc - 1][1] == 'P') {
+            showStats = 1;
+        } else {
+            showFork = 1;
+        }
+        argc--;
+    }
 
     /* 1) 初始化内核 */
     Kernel_Init();
+    if (showStats) {
+        Kernel_SetClock(DemoClockNs);
+    }
 
     /* 2) 创建演示进程，假设创建3个进程，每个进程可使用的最大页数不同，工作集大小也不同 */
     Kernel_CreateProcess(0, 10, 3);
     Kernel_CreateProcess(1, 12, 4);
     Kernel_CreateProcess(2, 8,  2);
 
+    /*
+     * 可选：第二个参数为共享页数N，三个进程的前N页映射到同一个共享段(模拟共享库代码页)
+     */
+    if (argc > 2) {
+        sharedPages = atoi(argv[2]);
+        if (sharedPages > 0) {
+            if (Kernel_CreateSharedSegment(0, sharedPages) != 0 ||
+                Kernel_MapSharedSegment(0, 0, 0, 0, sharedPages) != 0 ||
+                Kernel_MapSharedSegment(1, 0, 0, 0, sharedPages) != 0 ||
+                Kernel_MapSharedSegment(2, 0, 0, 0, sharedPages) != 0) {
+                printf("共享段创建失败(共享页数不能超过任一进程的最大页数)\n");
+                return 1;
+            }
+        }
+    }
+
     /*
      * 3) 从文件中读取引用序列，示例文件格式为:
      *    processId pageId
@@ -55,11 +192,11 @@ int main(int argc, char* argv[])
      */
     {
         ProcessControlBlock *table = Kernel_GetProcessTable();
-        int processCount = Kernel_GetProcessCount();
 
-        for (i = 0; i < processCount; i++) {
+        /* 销毁/fork 之后进程表可能有空槽，需遍历全部槽位 */
+        for (i = 0; i < MAX_PROCESSES; i++) {
             if (table[i].ws.processId == -1) {
-                continue; /* 无效进程 */
+                continue; /* 空槽 */
             }
             printf("进程 %d：\n", table[i].ws.processId);
             printf("  最大页数: %d\n", table[i].ws.pageCount);
@@ -74,6 +211,35 @@ int main(int argc, char* argv[])
         }
     }
 
+    if (showFork) {
+        DemoFork(0, 100);
+    }
+
+    /*
+     * 5) 有共享段时输出内存统计
+     */
+    if (sharedPages > 0) {
+        MemoryUsage usage;
+        ProcessControlBlock *table = Kernel_GetProcessTable();
+        int rssTotal = 0;
+
+        printf("内存统计(共享段 %d 页)：\n", sharedPages);
+        for (i = 0; i < MAX_PROCESSES; i++) {
+            if (table[i].ws.processId == -1 || Kernel_GetMemoryUsage(table[i].ws.processId, &usage) != 0) {
+                continue;
+            }
+            rssTotal += usage.rss;
+            printf("  进程 %d: RSS %d 页(其中共享 %d), PSS %.2f 页, USS %d 页\n",
+                   table[i].ws.processId, usage.rss, usage.sharedPages,
+                   (double)usage.pssScaled / (double)(1L << KERNEL_PSS_SHIFT), usage.uss);
+        }
+        printf("  RSS 之和: %d 页, 实际占用页框: %d 页\n\n", rssTotal, Kernel_GetResidentFrames());
+    }
+
+    if (showStats) {
+        PrintStats();
+    }
+
     printf("演示结束。\n");
     return 0;
 }
\ No newline at end of file
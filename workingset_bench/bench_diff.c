@@ -0,0 +1,360 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_diff.h"
+#include "../WSClock/wsclock_time.h"
+
+#define DIFF_MAX_TRIALS   4000     /* 缩减复现序列时最多尝试的次数 */
+#define DIFF_TIME_REFS    50000    /* 计时时至少回放的引用数 */
+
+static const DiffPair g_pairs[] = {
+    { "wsclock", engine_wsclock_create,      engine_wsclock_fast_create },
+    { "hand",    engine_wsclock_hand_create, engine_wsclock_hand_fast_create },
+    { "kernel",  engine_kernel_create,       engine_kernel_fast_create },
+};
+#define DIFF_PAIR_COUNT ((int)(sizeof(g_pairs) / sizeof(g_pairs[0])))
+
+const DiffPair* bench_diff_find(const char* name)
+{
+    for (int i = 0; name && i < DIFF_PAIR_COUNT; i++) {
+        if (strcmp(g_pairs[i].name, name) == 0) return &g_pairs[i];
+    }
+    return NULL;
+}
+
+/* 第一个在 a 中而不在 b 中的页 */
+static int first_only(const unsigned long long* a, const unsigned long long* b, int words)
+{
+    for (int w = 0; w < words; w++) {
+        unsigned long long d = a[w] & ~b[w];
+        if (d) return w * 64 + __builtin_ctzll(d);
+    }
+    return -1;
+}
+
+int bench_diff_run(const DiffPair* pair, const EngineConfig* config, const BenchTrace* trace, DiffResult* result)
+{
+    ReplayEngine ref, cand;
+    memset(&ref, 0, sizeof(ref));
+    memset(&cand, 0, sizeof(cand));
+    memset(result, 0, sizeof(DiffResult));
+    result->index = -1;
+    if (pair->reference(&ref, config) != 0) return -1;
+    if (pair->candidate(&cand, config) != 0) {
+        ref.destroy(&ref);
+        return -1;
+    }
+
+    int words = (config->page_count + 63) / 64;
+    unsigned long long* ref_bits = (unsigned long long*)malloc(sizeof(unsigned long long) * (size_t)words);
+    unsigned long long* cand_bits = (unsigned long long*)malloc(sizeof(unsigned long long) * (size_t)words);
+    int rc = (!ref_bits || !cand_bits || !ref.resident || !cand.resident) ? -1 : 0;
+
+    for (int i = 0; rc == 0 && i < trace->length; i++) {
+        int pid = trace->pids[i];
+        int page = trace->pages[i];
+        int fr = ref.access(&ref, pid, page);
+        int fc = cand.access(&cand, pid, page);
+        int diff_process = -1;
+        for (int p = 0; p < config->process_count && diff_process < 0; p++) {
+            int nr = ref.resident(&ref, p, ref_bits, words);
+            int nc = cand.resident(&cand, p, cand_bits, words);
+            if (nr != nc || memcmp(ref_bits, cand_bits, sizeof(unsigned long long) * (size_t)words) != 0) {
+                diff_process = p;
+            }
+        }
+        if (fr == fc && diff_process < 0) continue;
+
+        result->index = i;
+        result->process = pid;
+        result->page = page;
+        result->reference_fault = fr;
+        result->candidate_fault = fc;
+        result->diff_process = diff_process;
+        result->reference_only = diff_process >= 0 ? first_only(ref_bits, cand_bits, words) : -1;
+        result->candidate_only = diff_process >= 0 ? first_only(cand_bits, ref_bits, words) : -1;
+        rc = 1;
+    }
+
+    free(ref_bits);
+    free(cand_bits);
+    cand.destroy(&cand);
+    ref.destroy(&ref);
+    return rc;
+}
+
+int bench_diff_minimize(const DiffPair* pair, const EngineConfig* config, const BenchTrace* trace,
+                        const DiffResult* first, int max_trials, BenchTrace* out)
+{
+    memset(out, 0, sizeof(BenchTrace));
+    if (!first || first->index < 0 || first->index >= trace->length) return -1;
+
+    /* 回放是确定的，分歧之后的引用都不需要 */
+    size_t cap = (size_t)first->index + 1;
+    BenchTrace cur, trial;
+    cur.length = (int)cap;
+    cur.pids = (int*)malloc(sizeof(int) * cap);
+    cur.pages = (int*)malloc(sizeof(int) * cap);
+    trial.length = 0;
+    trial.pids = (int*)malloc(sizeof(int) * cap);
+    trial.pages = (int*)malloc(sizeof(int) * cap);
+    if (!cur.pids || !cur.pages || !trial.pids || !trial.pages) {
+        bench_trace_free(&cur);
+        bench_trace_free(&trial);
+        return -1;
+    }
+    memcpy(cur.pids, trace->pids, sizeof(int) * cap);
+    memcpy(cur.pages, trace->pages, sizeof(int) * cap);
+
+    /* 删除 [start, start+chunk)：仍有分歧就保留，并截到新的分歧位置 */
+    int trials = 0;
+    int chunk = cur.length / 2 > 0 ? cur.length / 2 : 1;
+    while (trials < max_trials) {
+        int removed = 0;
+        for (int start = 0; start < cur.length && cur.length > 1 && trials < max_trials; ) {
+            int end = start + chunk < cur.length ? start + chunk : cur.length;
+            trial.length = cur.length - (end - start);
+            memcpy(trial.pids, cur.pids, sizeof(int) * (size_t)start);
+            memcpy(trial.pages, cur.pages, sizeof(int) * (size_t)start);
+            memcpy(trial.pids + start, cur.pids + end, sizeof(int) * (size_t)(cur.length - end));
+            memcpy(trial.pages + start, cur.pages + end, sizeof(int) * (size_t)(cur.length - end));
+            trials++;
+
+            DiffResult r;
+            if (trial.length > 0 && bench_diff_run(pair, config, &trial, &r) == 1) {
+                BenchTrace t = cur;
+                cur = trial;
+                trial = t;
+                cur.length = r.index + 1;
+                removed = 1;
+            } else {
+                start += chunk;
+            }
+        }
+        /* 逐条删除也删不掉时已是 1-minimal */
+        if (chunk == 1 && !removed) break;
+        if (chunk > 1) chunk /= 2;
+        if (chunk > cur.length) chunk = cur.length;
+    }
+
+    bench_trace_free(&trial);
+    *out = cur;
+    return trials;
+}
+
+int bench_diff_write(const char* path, const char* pair_name, const EngineConfig* config, const BenchTrace* trace)
+{
+    FILE* fp = fopen(path, "w");
+    if (!fp) return -1;
+    fprintf(fp, "# -D %s -p %d -n %d -w %d -s %d\n", pair_name,
+            config->process_count, config->page_count, config->working_set_size, config->scan_period);
+    for (int i = 0; i < trace->length; i++) {
+        fprintf(fp, "%d %d\n", trace->pids[i], trace->pages[i]);
+    }
+    return fclose(fp) == 0 ? 0 : -1;
+}
+
+double bench_diff_time(EngineCreateFn create, const EngineConfig* config, const BenchTrace* trace)
+{
+    if (trace->length <= 0) return 0.0;
+    int reps = DIFF_TIME_REFS / trace->length + 1;
+    unsigned long long elapsed = 0;
+    for (int r = 0; r < reps; r++) {
+        ReplayEngine engine;
+        memset(&engine, 0, sizeof(engine));
+        if (create(&engine, config) != 0) return -1.0;
+        unsigned long long start_ns = wsclock_now_ns();
+        for (int i = 0; i < trace->length; i++) {
+            engine.access(&engine, trace->pids[i], trace->pages[i]);
+        }
+        elapsed += wsclock_now_ns() - start_ns;
+        engine.destroy(&engine);
+    }
+    return (double)elapsed / ((double)reps * (double)trace->length);
+}
+
+/* xorshift32 */
+static unsigned int diff_rand(unsigned int* s)
+{
+    unsigned int x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+int bench_diff_generate(unsigned int seed, EngineConfig* config, BenchTrace* out)
+{
+    unsigned int s = seed * 2654435761u + 1;
+    diff_rand(&s);
+
+    /* 页数不超过内核模块的 MAX_PAGES，进程数不超过 MAX_PROCESSES，三组实现都能使用 */
+    config->process_count = 1 + (int)(diff_rand(&s) % 4);
+    config->page_count = 1 + (int)(diff_rand(&s) % 96);
+    config->working_set_size = 1 + (int)(diff_rand(&s) % (unsigned int)config->page_count);
+    config->scan_period = diff_rand(&s) % 4 == 0 ? 0 : 1 + (int)(diff_rand(&s) % 12);
+
+    int length = 2000 + (int)(diff_rand(&s) % 4000);
+    memset(out, 0, sizeof(BenchTrace));
+    out->pids = (int*)malloc(sizeof(int) * (size_t)length);
+    out->pages = (int*)malloc(sizeof(int) * (size_t)length);
+    if (!out->pids || !out->pages) {
+        bench_trace_free(out);
+        return -1;
+    }
+
+    /* 每个进程一个局部窗口 [base, base+span) */
+    int base[4] = { 0, 0, 0, 0 };
+    int span[4] = { 1, 1, 1, 1 };
+    unsigned int window = (unsigned int)config->working_set_size * 2;
+    if (window > (unsigned int)config->page_count) window = (unsigned int)config->page_count;
+    for (int i = 0; i < length; i++) {
+        int pid = (int)(diff_rand(&s) % (unsigned int)config->process_count);
+        unsigned int r = diff_rand(&s) % 16;
+        if (r < 2) {
+            base[pid] = (int)(diff_rand(&s) % (unsigned int)config->page_count);
+            span[pid] = 1 + (int)(diff_rand(&s) % window);
+        }
+        int page = r == 15 ? (int)(diff_rand(&s) % (unsigned int)config->page_count)
+                           : (base[pid] + (int)(diff_rand(&s) % (unsigned int)span[pid])) % config->page_count;
+        out->pids[i] = pid;
+        out->pages[i] = page;
+    }
+    out->length = length;
+    return 0;
+}
+
+static void print_config(const EngineConfig* c)
+{
+    printf("-p %d -n %d -w %d -s %d", c->process_count, c->page_count, c->working_set_size, c->scan_period);
+}
+
+/* 报告分歧，缩减并写出复现序列 */
+static void report_divergence(const DiffPair* pair, const EngineConfig* config, const BenchTrace* trace,
+                              const DiffResult* r, const char* repro_path)
+{
+    printf("  第 %d 条引用(进程 %d, 页 %d)后出现分歧: 缺页结果 参考 %d / 候选 %d\n",
+           r->index + 1, r->process, r->page, r->reference_fault, r->candidate_fault);
+    if (r->diff_process >= 0) {
+        printf("  进程 %d 的驻留集不同: ", r->diff_process);
+        if (r->reference_only >= 0) printf("页 %d 只在参考实现中", r->reference_only);
+        if (r->reference_only >= 0 && r->candidate_only >= 0) printf("，");
+        if (r->candidate_only >= 0) printf("页 %d 只在候选实现中", r->candidate_only);
+        if (r->reference_only < 0 && r->candidate_only < 0) printf("位图相同但驻留页数不同");
+        printf("\n");
+    }
+
+    BenchTrace repro;
+    int trials = bench_diff_minimize(pair, config, trace, r, DIFF_MAX_TRIALS, &repro);
+    if (trials < 0) {
+        printf("  内存不足，无法缩减复现序列\n");
+        return;
+    }
+    printf("  缩减为 %d 条引用(尝试 %d 次%s)", repro.length, trials,
+           trials >= DIFF_MAX_TRIALS ? "，已达上限" : "");
+    if (bench_diff_write(repro_path, pair->name, config, &repro) == 0) {
+        printf("，已写入 %s\n", repro_path);
+        printf("  复现参数: %s -D %s ", repro_path, pair->name);
+        print_config(config);
+        printf(" -G 0\n");
+    } else {
+        printf("，无法写入 %s\n", repro_path);
+    }
+    bench_trace_free(&repro);
+}
+
+/* 验证一组实现；返回 0 一致，1 有分歧 */
+static int verify_pair(const DiffPair* pair, const char* trace_name, const BenchTrace* trace,
+                       const EngineConfig* config, int generated, const char* repro_path)
+{
+    ReplayEngine probe;
+    memset(&probe, 0, sizeof(probe));
+    const char* ref_name = pair->reference(&probe, config) == 0 ? probe.name : pair->name;
+    if (probe.destroy) probe.destroy(&probe);
+    memset(&probe, 0, sizeof(probe));
+    const char* cand_name = pair->candidate(&probe, config) == 0 ? probe.name : "?";
+    if (probe.destroy) probe.destroy(&probe);
+    printf("[%s] 参考 %s, 候选 %s\n", pair->name, ref_name, cand_name);
+
+    double ref_ns = 0.0, cand_ns = 0.0;
+    int recorded = 0;
+    DiffResult r;
+    if (trace && trace->length > 0) {
+        int rc = bench_diff_run(pair, config, trace, &r);
+        if (rc < 0) {
+            printf("  %s: 引擎不支持该配置，跳过\n", trace_name);
+        } else if (rc == 1) {
+            printf("  %s (", trace_name);
+            print_config(config);
+            printf(", %d 条引用):\n", trace->length);
+            report_divergence(pair, config, trace, &r, repro_path);
+            return 1;
+        } else {
+            ref_ns = bench_diff_time(pair->reference, config, trace);
+            cand_ns = bench_diff_time(pair->candidate, config, trace);
+            recorded = 1;
+        }
+    }
+
+    /* 生成的序列：按引用数加权汇总计时 */
+    double gen_ref = 0.0, gen_cand = 0.0;
+    long long gen_refs = 0;
+    for (int g = 1; g <= generated; g++) {
+        EngineConfig gc;
+        BenchTrace gt;
+        if (bench_diff_generate((unsigned int)g, &gc, &gt) != 0) {
+            printf("  内存不足\n");
+            return 1;
+        }
+        int rc = bench_diff_run(pair, &gc, &gt, &r);
+        if (rc == 1) {
+            printf("  生成序列 #%d (", g);
+            print_config(&gc);
+            printf(", %d 条引用):\n", gt.length);
+            report_divergence(pair, &gc, &gt, &r, repro_path);
+            bench_trace_free(&gt);
+            return 1;
+        }
+        if (rc == 0) {
+            gen_ref += bench_diff_time(pair->reference, &gc, &gt) * gt.length;
+            gen_cand += bench_diff_time(pair->candidate, &gc, &gt) * gt.length;
+            gen_refs += gt.length;
+        }
+        bench_trace_free(&gt);
+    }
+
+    /* 全部一致：报告加速比 */
+    printf("  每条引用后的缺页结果与驻留集全部一致\n");
+    printf("  %-28s %10s %12s %12s %8s\n", "trace", "refs", "ref ns/ref", "cand ns/ref", "speedup");
+    if (recorded) {
+        printf("  %-28s %10d %12.1f %12.1f %7.2fx\n", trace_name, trace->length,
+               ref_ns, cand_ns, cand_ns > 0.0 ? ref_ns / cand_ns : 0.0);
+    }
+    if (gen_refs > 0) {
+        char label[32];
+        snprintf(label, sizeof(label), "generated x%d", generated);
+        printf("  %-28s %10lld %12.1f %12.1f %7.2fx\n", label, gen_refs,
+               gen_ref / (double)gen_refs, gen_cand / (double)gen_refs,
+               gen_cand > 0.0 ? gen_ref / gen_cand : 0.0);
+    }
+    return 0;
+}
+
+int bench_diff_main(const char* pair_name, const char* trace_name, const BenchTrace* trace,
+                    const EngineConfig* config, int generated, const char* repro_path)
+{
+    int all = strcmp(pair_name, "all") == 0;
+    if (!all && !bench_diff_find(pair_name)) {
+        printf("未知的实现组: %s (可选 wsclock, hand, kernel, all)\n", pair_name);
+        return -1;
+    }
+    int failed = 0;
+    for (int i = 0; i < DIFF_PAIR_COUNT && !failed; i++) {
+        if (!all && strcmp(g_pairs[i].name, pair_name) != 0) continue;
+        failed = verify_pair(&g_pairs[i], trace_name, trace, config, generated, repro_path);
+        printf("\n");
+    }
+    printf("%s\n", failed ? "差分验证失败" : "差分验证通过");
+    return failed;
+}
@@ -0,0 +1,91 @@
+#ifndef BENCH_DIFF_H
+#define BENCH_DIFF_H
+
+#include "bench_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 差分验证：参考实现与候选的优化实现在同一序列上逐条同步回放，
+ * 每条引用后比较缺页结果和所有进程的驻留集，遇到第一处分歧就停止，
+ * 再把序列缩减成仍能复现分歧的最小序列写入文件
+ */
+
+typedef int (*EngineCreateFn)(ReplayEngine* engine, const EngineConfig* config);
+
+/* 一组待比较的实现 */
+typedef struct DiffPair {
+    const char* name;            /* 命令行使用的名称 */
+    EngineCreateFn reference;
+    EngineCreateFn candidate;
+} DiffPair;
+
+/* 第一处分歧；index 为 -1 表示全部一致 */
+typedef struct DiffResult {
+    int index;                   /* 分歧发生在第几条引用之后 */
+    int process;                 /* 该条引用的进程号与页号 */
+    int page;
+    int reference_fault;         /* 两边 access 的返回值 */
+    int candidate_fault;
+    int diff_process;            /* 驻留集不同的进程，只是缺页结果不同时为 -1 */
+    int reference_only;          /* 只在参考实现中驻留的第一个页，没有时为 -1 */
+    int candidate_only;          /* 只在候选实现中驻留的第一个页，没有时为 -1 */
+} DiffResult;
+
+/*
+ * 按名称查找 wsclock / hand / kernel
+ * 返回值: 找不到时为 NULL
+ */
+const DiffPair* bench_diff_find(const char* name);
+
+/*
+ * 同步回放整条序列
+ * 返回值:
+ *   - 0: 全部一致
+ *   - 1: 出现分歧，详情写入 result
+ *   - -1: 引擎不支持该配置或缺少 resident 接口
+ */
+int bench_diff_run(const DiffPair* pair, const EngineConfig* config, const BenchTrace* trace, DiffResult* result);
+
+/*
+ * 缩减复现序列：先截到第一处分歧为止，再按 ddmin 的方式成段删除引用，
+ * 删除后仍有分歧就保留删除(每次尝试都重新创建两个引擎)
+ * 参数:
+ *   - max_trials: 最多尝试次数，用完时返回当前结果
+ * 返回值: 尝试次数；内存不足时为 -1
+ */
+int bench_diff_minimize(const DiffPair* pair, const EngineConfig* config, const BenchTrace* trace,
+                        const DiffResult* first, int max_trials, BenchTrace* out);
+
+/*
+ * 以 "进程号 页号" 格式写出序列(bench_trace_load 可直接读取)，开头的注释行记录配置
+ */
+int bench_diff_write(const char* path, const char* pair_name, const EngineConfig* config, const BenchTrace* trace);
+
+/*
+ * 单独回放计时(不做比较)，序列较短时重复回放以减小计时误差
+ * 返回值: 每条引用的平均纳秒数；引擎不支持该配置时为负数
+ */
+double bench_diff_time(EngineCreateFn create, const EngineConfig* config, const BenchTrace* trace);
+
+/*
+ * 按种子生成序列与配置：随机的进程数、页数、工作集容量与扫描周期，
+ * 引用在局部窗口内随机游走，偶尔跳到新的窗口或均匀随机取页
+ */
+int bench_diff_generate(unsigned int seed, EngineConfig* config, BenchTrace* out);
+
+/*
+ * -D 模式入口：先验证给定的序列，再验证 generated 条生成的序列；
+ * 出现分歧时把最小复现序列写入 repro_path
+ * 返回值: 0 表示全部一致，1 表示有分歧，-1 表示参数非法
+ */
+int bench_diff_main(const char* pair_name, const char* trace_name, const BenchTrace* trace,
+                    const EngineConfig* config, int generated, const char* repro_path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_DIFF_H */
@@ -0,0 +1,74 @@
+#ifndef BENCH_ENGINE_H
+#define BENCH_ENGINE_H
+
+#include "bench_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 所有被比较的置换引擎使用相同的配置：进程数、每进程页数、工作集容量
+ */
+typedef struct EngineConfig {
+    int process_count;
+    int page_count;        /* 每个进程的页数 */
+    int working_set_size;  /* 每个进程的工作集容量 */
+    int scan_period;       /* WSClock 引擎每隔多少次引用执行一次 periodic_scan，
+                              MGLRU 引擎按同样的节奏老化一代(<=0 不扫描) */
+} EngineConfig;
+
+/*
+ * 统一的引擎接口：按序列顺序逐条喂入引用
+ *  - access: 返回 1 表示缺页，0 表示命中，-1 表示参数非法
+ *  - destroy: 释放引擎状态
+ *  - evictions / scanned: 由引擎在 access 中累加；scanned 为置换与周期扫描检查的页表项数，
+ *    has_scan_work 为0的引擎(OPT)不统计扫描开销
+ *  - resident: 可为NULL；把进程当前驻留(在工作集中)的页写成 words 个字的位图，返回驻留页数，
+ *    差分验证用它逐条比较参考实现与候选实现的驻留集
+ */
+typedef struct ReplayEngine ReplayEngine;
+struct ReplayEngine {
+    const char* name;
+    void* state;
+    unsigned long long evictions;
+    unsigned long long scanned;
+    int has_scan_work;
+    int  (*access)(ReplayEngine* engine, int process_index, int page_id);
+    int  (*resident)(ReplayEngine* engine, int process_index, unsigned long long* bits, int words);
+    void (*destroy)(ReplayEngine* engine);
+};
+
+/* WSClock/wsclock_kernel.c：最小 age 选择 victim */
+int engine_wsclock_create(ReplayEngine* engine, const EngineConfig* config);
+
+/* WSClock_1/wsclock_kernel.c：时钟指针 + 老化阈值 + 写回限制 */
+int engine_wsclock_hand_create(ReplayEngine* engine, const EngineConfig* config);
+
+/* os_keshe_workingset/kernel_module.c：Kernel_ReferencePage + Kernel_UpdateWorkingSets */
+int engine_kernel_create(ReplayEngine* engine, const EngineConfig* config);
+
+/* WSClock/wsclock_mglru.c：多代老化，回收只看最老一代 */
+int engine_mglru_create(ReplayEngine* engine, const EngineConfig* config);
+
+/*
+ * Belady OPT：离线最优置换，需要预先看到完整序列
+ * 引用必须严格按 trace 的顺序喂入
+ */
+int engine_opt_create(ReplayEngine* engine, const EngineConfig* config, const BenchTrace* trace);
+
+/*
+ * 候选的优化实现：语义与对应的参考实现逐条相同，由差分验证(bench_diff.h)检查
+ *  - engine_wsclock_fast_create: WSClock 的两条按 age 有序的链表，置换与周期扫描都是 O(1)
+ *  - engine_wsclock_hand_fast_create: WSClock_1 的工作集计数 + 位图，指针跳过不在工作集中的页
+ *  - engine_kernel_fast_create: 内核模块的每进程计数 + 位图，不再每次统计所有进程
+ */
+int engine_wsclock_fast_create(ReplayEngine* engine, const EngineConfig* config);
+int engine_wsclock_hand_fast_create(ReplayEngine* engine, const EngineConfig* config);
+int engine_kernel_fast_create(ReplayEngine* engine, const EngineConfig* config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_ENGINE_H */
@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_engine.h"
+#include "bench_diff.h"
+#include "../WSClock/wsclock_time.h"
+#include "../os_keshe_workingset/kernel_module.h"
+
+/*
+ * 置换策略对比：同一引用序列、同一配置下，
+ * 比较 OPT(下界)、WSClock、WSClock_1、MGLRU 与内核模块工作集的每进程缺页数，
+ * 以及各策略的置换次数与扫描开销(检查的页表项数)
+ * -D 模式改为差分验证：候选的优化实现与参考实现逐条比较(见 bench_diff.h)
+ */
+
+#define MAX_ENGINES 8
+
+static void print_usage(const char* prog)
+{
+    printf("用法: %s [引用序列文件] [-p 进程数] [-n 每进程页数] [-w 工作集容量] [-s 扫描周期]\n", prog);
+    printf("  默认与 WSClock/main.c 一致: ../WSClock/page_refs.txt -p 3 -n 6 -w 3 -s 5\n");
+    printf("  -D 实现组: 差分验证 wsclock | hand | kernel | all，依次验证给定序列与生成的序列\n");
+    printf("  -G 条数: 差分验证生成的序列条数(默认 50)\n");
+    printf("  -o 文件: 出现分歧时写出最小复现序列的文件(默认 diff_repro.txt)\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const char* trace_file = "../WSClock/page_refs.txt";
+    EngineConfig config;
+    config.process_count = 3;
+    config.page_count = 6;
+    config.working_set_size = 3;
+    config.scan_period = 5;
+    const char* diff_pair = 0;
+    int diff_generated = 50;
+    const char* diff_repro = "diff_repro.txt";
+
+    for (int ai = 1; ai < argc; ai++) {
+        if (strcmp(argv[ai], "-p") == 0 && ai + 1 < argc) {
+            config.process_count = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-n") == 0 && ai + 1 < argc) {
+            config.page_count = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-w") == 0 && ai + 1 < argc) {
+            config.working_set_size = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-s") == 0 && ai + 1 < argc) {
+            config.scan_period = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-D") == 0 && ai + 1 < argc) {
+            diff_pair = argv[++ai];
+        } else if (strcmp(argv[ai], "-G") == 0 && ai + 1 < argc) {
+            diff_generated = atoi(argv[++ai]);
+        } else if (strcmp(argv[ai], "-o") == 0 && ai + 1 < argc) {
+            diff_repro = argv[++ai];
+        } else if (argv[ai][0] == '-') {
+            print_usage(argv[0]);
+            return 1;
+        } else {
+            trace_file = argv[ai];
+        }
+    }
+    if (config.process_count <= 0 || config.page_count <= 0 || config.working_set_size <= 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    BenchTrace trace;
+    if (bench_trace_load(trace_file, config.process_count, &trace) != 0) {
+        printf("无法读取引用序列: %s\n", trace_file);
+        return 1;
+    }
+    int dropped = bench_trace_filter(&trace, config.process_count, config.page_count);
+    printf("引用序列 %s: %d 条有效引用(丢弃越界引用 %d 条)\n", trace_file, trace.length, dropped);
+    printf("配置: %d 个进程, 每进程 %d 页, 工作集容量 %d, 扫描周期 %d\n\n",
+           config.process_count, config.page_count, config.working_set_size, config.scan_period);
+
+    if (diff_pair) {
+        int rc = bench_diff_main(diff_pair, trace_file, &trace, &config, diff_generated, diff_repro);
+        bench_trace_free(&trace);
+        return rc == 0 ? 0 : 1;
+    }
+
+    /* 创建各引擎，OPT 放在第一列作为基准 */
+    ReplayEngine engines[MAX_ENGINES];
+    int engine_count = 0;
+    memset(engines, 0, sizeof(engines));
+    if (engine_opt_create(&engines[engine_count], &config, &trace) == 0) engine_count++;
+    if (engine_wsclock_create(&engines[engine_count], &config) == 0) engine_count++;
+    if (engine_wsclock_hand_create(&engines[engine_count], &config) == 0) engine_count++;
+    if (engine_mglru_create(&engines[engine_count], &config) == 0) engine_count++;
+    if (engine_kernel_create(&engines[engine_count], &config) == 0) {
+        engine_count++;
+    } else {
+        printf("内核模块引擎不支持该配置(最多 %d 个进程、每进程 %d 页)，已跳过\n\n",
+               MAX_PROCESSES, MAX_PAGES);
+    }
+
+    unsigned long* faults = (unsigned long*)calloc((size_t)engine_count * (size_t)config.process_count,
+                                                   sizeof(unsigned long));
+    unsigned long* refs = (unsigned long*)calloc((size_t)config.process_count, sizeof(unsigned long));
+    unsigned long long elapsed_ns[MAX_ENGINES];
+    memset(elapsed_ns, 0, sizeof(elapsed_ns));
+    if (!faults || !refs) {
+        printf("内存不足\n");
+        return 1;
+    }
+
+    for (int i = 0; i < trace.length; i++) {
+        int pid = trace.pids[i];
+        int page = trace.pages[i];
+        refs[pid]++;
+        for (int e = 0; e < engine_count; e++) {
+            unsigned long long start_ns = wsclock_now_ns();
+            int fault = engines[e].access(&engines[e], pid, page);
+            elapsed_ns[e] += wsclock_now_ns() - start_ns;
+            if (fault == 1) {
+                faults[e * config.process_count + pid]++;
+            }
+        }
+    }
+
+    /* 每进程缺页数 */
+    printf("%-8s %-8s", "pid", "refs");
+    for (int e = 0; e < engine_count; e++) printf(" %10s", engines[e].name);
+    printf("\n");
+    unsigned long total_refs = 0;
+    for (int pid = 0; pid < config.process_count; pid++) {
+        printf("%-8d %-8lu", pid, refs[pid]);
+        for (int e = 0; e < engine_count; e++) {
+            printf(" %10lu", faults[e * config.process_count + pid]);
+        }
+        printf("\n");
+        total_refs += refs[pid];
+    }
+
+    unsigned long totals[MAX_ENGINES];
+    printf("%-8s %-8lu", "total", total_refs);
+    for (int e = 0; e < engine_count; e++) {
+        totals[e] = 0;
+        for (int pid = 0; pid < config.process_count; pid++) {
+            totals[e] += faults[e * config.process_count + pid];
+        }
+        printf(" %10lu", totals[e]);
+    }
+    printf("\n\n");
+
+    /* 与 OPT 下界的差距：可优化空间 */
+    if (engine_count > 0 && totals[0] > 0) {
+        printf("相对 OPT 的额外缺页(可优化空间):\n");
+        for (int e = 1; e < engine_count; e++) {
+            printf("  %-10s 缺页率 %.2f%%, 与 OPT 相差 %+ld 次 (%+.1f%%)\n",
+                   engines[e].name,
+                   total_refs ? 100.0 * (double)totals[e] / (double)total_refs : 0.0,
+                   (long)totals[e] - (long)totals[0],
+                   100.0 * ((double)totals[e] - (double)totals[0]) / (double)totals[0]);
+        }
+        for (int e = 1; e < engine_count; e++) {
+            if (totals[e] < totals[0]) {
+                /*
+                 * OPT 是按需调页(每次缺页都装入该页)、容量固定下的下界。
+                 * WSClock_1 找不到 victim 时工作集会超过容量；内核模块可能把刚引用的页
+                 * 立即移出工作集(相当于不缓存该页)，二者都不受该下界约束。
+                 */
+                printf("  注: %s 低于 OPT，说明其工作集超过了容量或未装入被引用页，不满足按需调页前提\n",
+                       engines[e].name);
+            }
+        }
+    }
+
+    /* 置换与扫描开销：每次引用、每次置换平均检查的页表项数 */
+    printf("\n%-10s %10s %10s %12s %10s %10s %10s\n",
+           "engine", "faults", "evictions", "scanned", "scan/ref", "scan/evict", "ns/ref");
+    for (int e = 0; e < engine_count; e++) {
+        printf("%-10s %10lu %10llu", engines[e].name, totals[e], engines[e].evictions);
+        if (engines[e].has_scan_work) {
+            printf(" %12llu %10.2f %10.2f", engines[e].scanned,
+                   total_refs ? (double)engines[e].scanned / (double)total_refs : 0.0,
+                   engines[e].evictions ? (double)engines[e].scanned / (double)engines[e].evictions : 0.0);
+        } else {
+            printf(" %12s %10s %10s", "-", "-", "-");
+        }
+        printf(" %10.1f\n", total_refs ? (double)elapsed_ns[e] / (double)total_refs : 0.0);
+    }
+
+    for (int e = 0; e < engine_count; e++) {
+        engines[e].destroy(&engines[e]);
+    }
+    free(faults);
+    free(refs);
+    bench_trace_free(&trace);
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_trace.h"
+#include "../WSClock/wsclock_trace.c"
+
+/* 追加一条引用，必要时扩容 */
+static int trace_push(BenchTrace* t, int* capacity, int pid, int page)
+{
+    if (t->length >= *capacity) {
+        int new_cap = *capacity ? *capacity * 2 : 256;
+        int* pids = (int*)realloc(t->pids, sizeof(int) * (size_t)new_cap);
+        if (!pids) return -1;
+        t->pids = pids;
+        int* pages = (int*)realloc(t->pages, sizeof(int) * (size_t)new_cap);
+        if (!pages) return -1;
+        t->pages = pages;
+        *capacity = new_cap;
+    }
+    t->pids[t->length] = pid;
+    t->pages[t->length] = page;
+    t->length++;
+    return 0;
+}
+
+/* 压缩格式：带进程号时直接使用，否则与每行一个页号的文本格式一样按轮转方式分配 */
+static int trace_load_compressed(const char* filename, int process_count, BenchTrace* out)
+{
+    WSClockTrace trace;
+    if (wsclock_trace_open(&trace, filename) != 0) return -1;
+    int rc = -1;
+    if (trace.total_refs < 0x7fffffffLL) {
+        size_t n = (size_t)(trace.total_refs > 0 ? trace.total_refs : 1);
+        out->pids = (int*)malloc(sizeof(int) * n);
+        out->pages = (int*)malloc(sizeof(int) * n);
+        if (out->pids && out->pages && wsclock_trace_decode_all(&trace, out->pages, out->pids, 4) == 0) {
+            out->length = (int)trace.total_refs;
+            if (!(trace.flags & WSCLOCK_TRACE_PIDS)) {
+                for (int i = 0; i < out->length; i++) out->pids[i] = i % process_count;
+            }
+            rc = 0;
+        }
+    }
+    wsclock_trace_close(&trace);
+    if (rc != 0) bench_trace_free(out);
+    return rc;
+}
+
+int bench_trace_load(const char* filename, int process_count, BenchTrace* out)
+{
+    if (!filename || !out || process_count <= 0) return -1;
+    memset(out, 0, sizeof(BenchTrace));
+    if (wsclock_trace_is_compressed(filename)) {
+        return trace_load_compressed(filename, process_count, out);
+    }
+
+    FILE* fp = fopen(filename, "r");
+    if (!fp) return -1;
+
+    char line[256];
+    int capacity = 0;
+    int paired = -1; /* -1: 未确定格式, 1: 进程号+页号, 0: 仅页号 */
+    int flat_index = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        int a, b;
+        int n = sscanf(line, "%d %d", &a, &b);
+        if (n <= 0) continue;
+        if (paired < 0) {
+            paired = (n == 2);
+        }
+        int rc;
+        if (paired) {
+            if (n != 2) continue;
+            rc = trace_push(out, &capacity, a, b);
+        } else {
+            rc = trace_push(out, &capacity, flat_index % process_count, a);
+            flat_index++;
+        }
+        if (rc != 0) {
+            fclose(fp);
+            bench_trace_free(out);
+            return -1;
+        }
+    }
+    fclose(fp);
+    return 0;
+}
+
+int bench_trace_filter(BenchTrace* trace, int process_count, int page_count)
+{
+    int kept = 0;
+    for (int i = 0; i < trace->length; i++) {
+        int pid = trace->pids[i];
+        int page = trace->pages[i];
+        if (pid < 0 || pid >= process_count || page < 0 || page >= page_count) {
+            continue;
+        }
+        trace->pids[kept] = pid;
+        trace->pages[kept] = page;
+        kept++;
+    }
+    int dropped = trace->length - kept;
+    trace->length = kept;
+    return dropped;
+}
+
+void bench_trace_free(BenchTrace* trace)
+{
+    if (!trace) return;
+    free(trace->pids);
+    free(trace->pages);
+    memset(trace, 0, sizeof(BenchTrace));
+}
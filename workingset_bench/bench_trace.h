@@ -0,0 +1,43 @@
+#ifndef BENCH_TRACE_H
+#define BENCH_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 对比测试使用的引用序列：每条引用记录(进程号, 页号)
+ */
+typedef struct BenchTrace {
+    int length;     /* 引用条数 */
+    int* pids;      /* 每条引用的进程号 */
+    int* pages;     /* 每条引用的页号 */
+} BenchTrace;
+
+/*
+ * 读取引用序列文件，自动识别两种格式：
+ *   - "processId pageId" 每行一对(os_keshe_workingset/references.txt 的格式)
+ *   - 每行一个页号(WSClock/page_refs.txt 的格式)，按轮转方式依次分配给 process_count 个进程
+ * 以及 WSClock/wsclock_trace.h 的压缩格式(带进程号时直接使用，否则同样按轮转方式分配)
+ * 返回值:
+ *   - 0: 成功
+ *   - -1: 文件无法打开或内存不足
+ */
+int bench_trace_load(const char* filename, int process_count, BenchTrace* out);
+
+/*
+ * 丢弃进程号或页号越界的引用(各引擎都会忽略这些引用，先统一过滤以便结果对齐)
+ * 返回值: 丢弃的条数
+ */
+int bench_trace_filter(BenchTrace* trace, int process_count, int page_count);
+
+/*
+ * 释放序列占用的内存
+ */
+void bench_trace_free(BenchTrace* trace);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_TRACE_H */
@@ -0,0 +1,109 @@
+/*
+ * os_keshe_workingset 内核模块引擎适配
+ * 内核模块使用全局进程表，因此同一时刻只能存在一个该引擎实例
+ */
+#include "../os_keshe_workingset/kernel_module.c"
+
+#include <stdlib.h>
+#include <string.h>
+#include "bench_engine.h"
+
+typedef struct KernelEngineState {
+    int process_count;
+    int total_pages;      /* 所有进程的页表项总数 */
+} KernelEngineState;
+
+/* 按进程号查找进程控制块 */
+static ProcessControlBlock* kernel_engine_find(int processId)
+{
+    ProcessControlBlock* table = Kernel_GetProcessTable();
+    for (int i = 0; i < MAX_PROCESSES; i++) {
+        if (table[i].ws.processId == processId) {
+            return &table[i];
+        }
+    }
+    return 0;
+}
+
+static int kernel_engine_ws_count(const ProcessControlBlock* pcb)
+{
+    int count = 0;
+    for (int j = 0; j < pcb->ws.pageCount; j++) {
+        count += pcb->ws.pages[j].inWorkingSet ? 1 : 0;
+    }
+    return count;
+}
+
+static int kernel_engine_access(ReplayEngine* engine, int process_index, int page_id)
+{
+    ProcessControlBlock* pcb = kernel_engine_find(process_index);
+    if (!pcb || page_id < 0 || page_id >= pcb->ws.pageCount) return -1;
+
+    /* 与 mian.c 相同：每次成功引用后立即更新工作集 */
+    int fault = !pcb->ws.pages[page_id].inWorkingSet;
+    if (Kernel_ReferencePage(process_index, page_id) != 0) return -1;
+
+    /*
+     * Kernel_UpdateWorkingSets 每次都统计所有进程的全部页表项；
+     * 超出容量时再从页0开始找第一个在工作集中的页移除(可能正是刚引用的页)
+     */
+    KernelEngineState* st = (KernelEngineState*)engine->state;
+    engine->scanned += (unsigned long long)st->total_pages;
+    if (fault && kernel_engine_ws_count(pcb) > pcb->ws.workingSetSize) {
+        int first = 0;
+        while (!pcb->ws.pages[first].inWorkingSet) first++;
+        engine->scanned += (unsigned long long)(first + 1);
+        engine->evictions++;
+    }
+    Kernel_UpdateWorkingSets();
+    return fault;
+}
+
+static int kernel_engine_resident(ReplayEngine* engine, int process_index, unsigned long long* bits, int words)
+{
+    (void)engine;
+    const ProcessControlBlock* pcb = kernel_engine_find(process_index);
+    if (!pcb) return -1;
+    int count = 0;
+    memset(bits, 0, sizeof(unsigned long long) * (size_t)words);
+    for (int j = 0; j < pcb->ws.pageCount && j / 64 < words; j++) {
+        if (pcb->ws.pages[j].inWorkingSet) {
+            bits[j / 64] |= 1ULL << (j % 64);
+            count++;
+        }
+    }
+    return count;
+}
+
+static void kernel_engine_destroy(ReplayEngine* engine)
+{
+    free(engine->state);
+    engine->state = 0;
+}
+
+int engine_kernel_create(ReplayEngine* engine, const EngineConfig* config)
+{
+    if (config->process_count > MAX_PROCESSES || config->page_count > MAX_PAGES) {
+        return -1;
+    }
+    KernelEngineState* st = (KernelEngineState*)calloc(1, sizeof(KernelEngineState));
+    if (!st) return -1;
+
+    Kernel_Init();
+    for (int i = 0; i < config->process_count; i++) {
+        if (Kernel_CreateProcess(i, config->page_count, config->working_set_size) != 0) {
+            free(st);
+            return -1;
+        }
+    }
+    st->process_count = config->process_count;
+    st->total_pages = config->process_count * config->page_count;
+
+    engine->name = "Kernel";
+    engine->state = st;
+    engine->has_scan_work = 1;
+    engine->access = kernel_engine_access;
+    engine->resident = kernel_engine_resident;
+    engine->destroy = kernel_engine_destroy;
+    return 0;
+}
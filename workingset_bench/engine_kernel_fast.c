@@ -0,0 +1,98 @@
+/*
+ * 内核模块工作集的增量实现，作为差分验证的候选引擎
+ *
+ * Kernel_UpdateWorkingSets 每次都统计所有进程的全部页表项，超出容量时从页0开始移除。
+ * 每次引用后都会调用它，所以只有刚引用的进程可能超出容量，而且至多超出一页。
+ * 这里为每个进程维护工作集位图和计数：缺页时置位，超出容量时清掉最低的一位(可能正是刚置位的页)
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "bench_engine.h"
+
+typedef struct KernelFastProc {
+    int page_count;
+    int working_set_size;
+    int ws_count;
+    unsigned long long* bits;  /* 工作集位图 */
+} KernelFastProc;
+
+typedef struct KernelFastEngineState {
+    KernelFastProc* procs;
+    int process_count;
+    int words;                 /* 每个进程位图的字数 */
+} KernelFastEngineState;
+
+static int kernel_fast_engine_access(ReplayEngine* engine, int process_index, int page_id)
+{
+    KernelFastEngineState* st = (KernelFastEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->process_count) return -1;
+    KernelFastProc* p = &st->procs[process_index];
+    if (page_id < 0 || page_id >= p->page_count) return -1;
+
+    unsigned long long mask = 1ULL << (page_id % 64);
+    if (p->bits[page_id / 64] & mask) return 0;
+
+    p->bits[page_id / 64] |= mask;
+    p->ws_count++;
+    if (p->ws_count > p->working_set_size) {
+        int w = 0;
+        while (!p->bits[w]) w++;
+        p->bits[w] &= p->bits[w] - 1;
+        p->ws_count--;
+        engine->scanned += (unsigned long long)(w + 1);
+        engine->evictions++;
+    }
+    return 1;
+}
+
+static int kernel_fast_engine_resident(ReplayEngine* engine, int process_index, unsigned long long* bits, int words)
+{
+    KernelFastEngineState* st = (KernelFastEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->process_count) return -1;
+    const KernelFastProc* p = &st->procs[process_index];
+    int n = words < st->words ? words : st->words;
+    memset(bits, 0, sizeof(unsigned long long) * (size_t)words);
+    memcpy(bits, p->bits, sizeof(unsigned long long) * (size_t)n);
+    return p->ws_count;
+}
+
+static void kernel_fast_engine_destroy(ReplayEngine* engine)
+{
+    KernelFastEngineState* st = (KernelFastEngineState*)engine->state;
+    if (!st) return;
+    for (int i = 0; st->procs && i < st->process_count; i++) {
+        free(st->procs[i].bits);
+    }
+    free(st->procs);
+    free(st);
+    engine->state = 0;
+}
+
+int engine_kernel_fast_create(ReplayEngine* engine, const EngineConfig* config)
+{
+    KernelFastEngineState* st = (KernelFastEngineState*)calloc(1, sizeof(KernelFastEngineState));
+    if (!st) return -1;
+    st->process_count = config->process_count;
+    st->words = (config->page_count + 63) / 64;
+    st->procs = (KernelFastProc*)calloc((size_t)config->process_count, sizeof(KernelFastProc));
+    int ok = st->procs != 0;
+    for (int i = 0; ok && i < config->process_count; i++) {
+        KernelFastProc* p = &st->procs[i];
+        p->page_count = config->page_count;
+        p->working_set_size = config->working_set_size;
+        p->bits = (unsigned long long*)calloc((size_t)st->words, sizeof(unsigned long long));
+        ok = p->bits != 0;
+    }
+    engine->state = st;
+    if (!ok) {
+        kernel_fast_engine_destroy(engine);
+        return -1;
+    }
+
+    engine->name = "Kernel-inc";
+    engine->has_scan_work = 1;
+    engine->access = kernel_fast_engine_access;
+    engine->resident = kernel_fast_engine_resident;
+    engine->destroy = kernel_fast_engine_destroy;
+    return 0;
+}
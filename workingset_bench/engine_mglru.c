@@ -0,0 +1,75 @@
+/*
+ * 多代老化(MGLRU 风格)引擎适配
+ */
+#include "../WSClock/wsclock_mglru.c"
+
+#include <stdlib.h>
+#include "bench_engine.h"
+
+typedef struct MglruEngineState {
+    WSClockMglru* procs;
+    int process_count;
+    int scan_period;
+    unsigned long refs;
+} MglruEngineState;
+
+static int mglru_engine_access(ReplayEngine* engine, int process_index, int page_id)
+{
+    MglruEngineState* st = (MglruEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->process_count) return -1;
+
+    WSClockMglru* m = &st->procs[process_index];
+    unsigned long long scanned = m->scanned;
+    int result = wsclock_mglru_access(m, page_id, 0);
+    if (result == WSCLOCK_ACCESS_INVALID) return -1;
+    engine->scanned += m->scanned - scanned;
+    if (result & WSCLOCK_ACCESS_EVICT) engine->evictions++;
+
+    /* 与 WSClock 引擎相同的节奏老化：每次只是新建一代，不扫描页面 */
+    st->refs++;
+    if (st->scan_period > 0 && st->refs % (unsigned long)st->scan_period == 0) {
+        for (int i = 0; i < st->process_count; i++) {
+            wsclock_mglru_age(&st->procs[i]);
+        }
+    }
+    return (result & WSCLOCK_ACCESS_FAULT) ? 1 : 0;
+}
+
+static void mglru_engine_destroy(ReplayEngine* engine)
+{
+    MglruEngineState* st = (MglruEngineState*)engine->state;
+    if (!st) return;
+    for (int i = 0; i < st->process_count; i++) {
+        wsclock_mglru_free(&st->procs[i]);
+    }
+    free(st->procs);
+    free(st);
+    engine->state = 0;
+}
+
+int engine_mglru_create(ReplayEngine* engine, const EngineConfig* config)
+{
+    MglruEngineState* st = (MglruEngineState*)calloc(1, sizeof(MglruEngineState));
+    if (!st) return -1;
+    st->procs = (WSClockMglru*)calloc((size_t)config->process_count, sizeof(WSClockMglru));
+    if (!st->procs) {
+        free(st);
+        return -1;
+    }
+    st->process_count = config->process_count;
+    st->scan_period = config->scan_period;
+    for (int i = 0; i < config->process_count; i++) {
+        if (wsclock_mglru_init(&st->procs[i], config->page_count, config->working_set_size) != 0) {
+            engine->state = st;
+            mglru_engine_destroy(engine);
+            return -1;
+        }
+    }
+
+    engine->name = "MGLRU";
+    engine->state = st;
+    engine->has_scan_work = 1;
+    engine->access = mglru_engine_access;
+    engine->destroy = mglru_engine_destroy;
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * Belady OPT 离线最优置换引擎
+ *  - 预处理：对整条序列做一次反向扫描，得到每条引用的"下一次使用位置"(next-use 索引)
+ *  - 运行：每个进程的驻留页放在以下一次使用位置为键的大顶堆中，
+ *    缺页且工作集已满时淘汰堆顶(最晚才会再被使用的页)，每次引用 O(log k)
+ * 得到的缺页数是同一工作集容量下任何按需调页策略的下界
+ */
+#include <stdlib.h>
+#include "bench_engine.h"
+
+typedef struct OptEngineState {
+    const BenchTrace* trace;
+    int cursor;             /* 下一条应喂入的引用下标 */
+    int* next_use;          /* next_use[i]: 引用 i 之后同一页的下一次引用下标，无则为 trace->length */
+    int process_count;
+    int page_count;
+    int capacity;           /* 每进程工作集容量 */
+    int* heap_page;         /* 每进程一段长度为 capacity 的堆：页号 */
+    int* heap_key;          /* 对应的下一次使用位置 */
+    int* heap_size;         /* 每进程堆中元素个数 */
+    int* heap_pos;          /* heap_pos[pid*page_count+page]: 该页在堆中的位置，-1 表示未驻留 */
+} OptEngineState;
+
+static void opt_heap_swap(OptEngineState* st, int pid, int a, int b)
+{
+    int base = pid * st->capacity;
+    int pa = st->heap_page[base + a];
+    int pb = st->heap_page[base + b];
+    int ka = st->heap_key[base + a];
+    st->heap_page[base + a] = pb;
+    st->heap_key[base + a] = st->heap_key[base + b];
+    st->heap_page[base + b] = pa;
+    st->heap_key[base + b] = ka;
+    st->heap_pos[pid * st->page_count + pb] = a;
+    st->heap_pos[pid * st->page_count + pa] = b;
+}
+
+static void opt_heap_sift_up(OptEngineState* st, int pid, int i)
+{
+    int base = pid * st->capacity;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (st->heap_key[base + parent] >= st->heap_key[base + i]) break;
+        opt_heap_swap(st, pid, parent, i);
+        i = parent;
+    }
+}
+
+static void opt_heap_sift_down(OptEngineState* st, int pid, int i)
+{
+    int base = pid * st->capacity;
+    int size = st->heap_size[pid];
+    for (;;) {
+        int largest = i;
+        int l = 2 * i + 1;
+        int r = l + 1;
+        if (l < size && st->heap_key[base + l] > st->heap_key[base + largest]) largest = l;
+        if (r < size && st->heap_key[base + r] > st->heap_key[base + largest]) largest = r;
+        if (largest == i) break;
+        opt_heap_swap(st, pid, i, largest);
+        i = largest;
+    }
+}
+
+static int opt_engine_access(ReplayEngine* engine, int process_index, int page_id)
+{
+    OptEngineState* st = (OptEngineState*)engine->state;
+    const BenchTrace* t = st->trace;
+
+    /* OPT 依赖预先计算的 next-use 索引，只能按序列原顺序回放 */
+    if (st->cursor >= t->length ||
+        t->pids[st->cursor] != process_index || t->pages[st->cursor] != page_id) {
+        return -1;
+    }
+    int next = st->next_use[st->cursor++];
+
+    int base = process_index * st->capacity;
+    int slot = process_index * st->page_count + page_id;
+    int pos = st->heap_pos[slot];
+    if (pos >= 0) {
+        /* 命中：下一次使用位置只会后移，键变大，上浮 */
+        st->heap_key[base + pos] = next;
+        opt_heap_sift_up(st, process_index, pos);
+        return 0;
+    }
+
+    if (st->heap_size[process_index] >= st->capacity) {
+        /* 淘汰最晚才会被再次使用的页 */
+        engine->evictions++;
+        int last = st->heap_size[process_index] - 1;
+        st->heap_pos[process_index * st->page_count + st->heap_page[base]] = -1;
+        if (last > 0) {
+            st->heap_page[base] = st->heap_page[base + last];
+            st->heap_key[base] = st->heap_key[base + last];
+            st->heap_pos[process_index * st->page_count + st->heap_page[base]] = 0;
+        }
+        st->heap_size[process_index]--;
+        opt_heap_sift_down(st, process_index, 0);
+    }
+
+    int i = st->heap_size[process_index]++;
+    st->heap_page[base + i] = page_id;
+    st->heap_key[base + i] = next;
+    st->heap_pos[slot] = i;
+    opt_heap_sift_up(st, process_index, i);
+    return 1;
+}
+
+static void opt_engine_destroy(ReplayEngine* engine)
+{
+    OptEngineState* st = (OptEngineState*)engine->state;
+    if (!st) return;
+    free(st->next_use);
+    free(st->heap_page);
+    free(st->heap_key);
+    free(st->heap_size);
+    free(st->heap_pos);
+    free(st);
+    engine->state = 0;
+}
+
+int engine_opt_create(ReplayEngine* engine, const EngineConfig* config, const BenchTrace* trace)
+{
+    if (!config || !trace || config->working_set_size <= 0) return -1;
+
+    OptEngineState* st = (OptEngineState*)calloc(1, sizeof(OptEngineState));
+    if (!st) return -1;
+    st->trace = trace;
+    st->process_count = config->process_count;
+    st->page_count = config->page_count;
+    st->capacity = config->working_set_size;
+
+    size_t slots = (size_t)config->process_count * (size_t)config->page_count;
+    size_t heap_slots = (size_t)config->process_count * (size_t)st->capacity;
+    st->next_use = (int*)malloc(sizeof(int) * (size_t)(trace->length > 0 ? trace->length : 1));
+    st->heap_page = (int*)malloc(sizeof(int) * heap_slots);
+    st->heap_key = (int*)malloc(sizeof(int) * heap_slots);
+    st->heap_size = (int*)calloc((size_t)config->process_count, sizeof(int));
+    st->heap_pos = (int*)malloc(sizeof(int) * slots);
+    if (!st->next_use || !st->heap_page || !st->heap_key || !st->heap_size || !st->heap_pos) {
+        engine->state = st;
+        opt_engine_destroy(engine);
+        return -1;
+    }
+
+    /* 反向扫描一次建立 next-use 索引；heap_pos 暂作"最近一次出现位置"表使用 */
+    for (size_t k = 0; k < slots; k++) {
+        st->heap_pos[k] = trace->length;
+    }
+    for (int i = trace->length - 1; i >= 0; i--) {
+        int pid = trace->pids[i];
+        int page = trace->pages[i];
+        if (pid < 0 || pid >= config->process_count || page < 0 || page >= config->page_count) {
+            st->next_use[i] = trace->length;
+            continue;
+        }
+        size_t k = (size_t)pid * (size_t)config->page_count + (size_t)page;
+        st->next_use[i] = st->heap_pos[k];
+        st->heap_pos[k] = i;
+    }
+    for (size_t k = 0; k < slots; k++) {
+        st->heap_pos[k] = -1;
+    }
+
+    engine->name = "OPT";
+    engine->state = st;
+    engine->access = opt_engine_access;
+    engine->destroy = opt_engine_destroy;
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * WSClock(最小 age 版本)引擎适配
+ * 各目录按 "gcc *.c" 独立构建，这里直接包含原实现的源文件，保证比较的是同一份代码
+ */
+#include "../WSClock/wsclock_kernel.c"
+#include "../WSClock/wsclock_stats.c"
+#include "../WSClock/wsclock_arena.c"
+
+#include <stdlib.h>
+#include <string.h>
+#include "bench_engine.h"
+
+typedef struct WSClockEngineState {
+    WSClockEnvironment env;
+    WSClockArena arena;          /* 进程与页表的分配器，由 env 持有 */
+    Process* procs;
+    int scan_period;
+    unsigned long refs;
+} WSClockEngineState;
+
+static int wsclock_engine_access(ReplayEngine* engine, int process_index, int page_id)
+{
+    WSClockEngineState* st = (WSClockEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->env.process_count) return -1;
+    Process* proc = &st->procs[process_index];
+    if (page_id < 0 || page_id >= proc->page_count) return -1;
+
+    /* find_victim_page 的两轮扫描量由进程计数器精确累计(WSCLOCK_STATS 打开时)，调用后取增量 */
+    unsigned long long victim_scanned = proc->counters.victim_pages_scanned;
+    int result = wsclock_access_page(&st->env, process_index, page_id);
+    int fault = (result & WSCLOCK_ACCESS_FAULT) != 0;
+    if (result & WSCLOCK_ACCESS_EVICT) engine->evictions++;
+    engine->scanned += proc->counters.victim_pages_scanned - victim_scanned;
+
+    /* 与 WSClock/main.c 相同的扫描节奏：每 scan_period 次引用清理所有进程的引用位 */
+    st->refs++;
+    if (st->scan_period > 0 && st->refs % (unsigned long)st->scan_period == 0) {
+        for (int i = 0; i < st->env.process_count; i++) {
+            wsclock_periodic_scan(&st->env, i);
+            engine->scanned += (unsigned long long)st->procs[i].page_count;
+        }
+    }
+    return fault;
+}
+
+static int wsclock_engine_resident(ReplayEngine* engine, int process_index, unsigned long long* bits, int words)
+{
+    WSClockEngineState* st = (WSClockEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->env.process_count) return -1;
+    const Process* proc = &st->procs[process_index];
+    memset(bits, 0, sizeof(unsigned long long) * (size_t)words);
+    for (int i = 0; i < proc->page_count && i / 64 < words; i++) {
+        if (wsclock_page(proc, i)->in_working_set) bits[i / 64] |= 1ULL << (i % 64);
+    }
+    return proc->ws_count;
+}
+
+static void wsclock_engine_destroy(ReplayEngine* engine)
+{
+    WSClockEngineState* st = (WSClockEngineState*)engine->state;
+    if (!st) return;
+    wsclock_cleanup(&st->env);
+    free(st);
+    engine->state = 0;
+}
+
+int engine_wsclock_create(ReplayEngine* engine, const EngineConfig* config)
+{
+    WSClockEngineState* st = (WSClockEngineState*)calloc(1, sizeof(WSClockEngineState));
+    if (!st) return -1;
+    wsclock_arena_init(&st->arena, 0, WSCLOCK_ARENA_HUGEPAGE);
+    st->procs = (Process*)wsclock_arena_alloc(&st->arena, sizeof(Process) * (size_t)config->process_count);
+    for (int i = 0; st->procs && i < config->process_count; i++) {
+        if (wsclock_process_create(&st->arena, &st->procs[i], i,
+                                   config->page_count, config->working_set_size) != 0) {
+            st->procs = 0;
+        }
+    }
+    if (!st->procs) {
+        wsclock_arena_destroy(&st->arena);
+        free(st);
+        return -1;
+    }
+    wsclock_init(&st->env, st->procs, config->process_count, 0);
+    wsclock_arena_attach(&st->env, &st->arena);
+    st->scan_period = config->scan_period;
+
+    engine->name = "WSClock";
+    engine->state = st;
+    engine->has_scan_work = 1;
+    engine->access = wsclock_engine_access;
+    engine->resident = wsclock_engine_resident;
+    engine->destroy = wsclock_engine_destroy;
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * WSClock(最小 age 版本)的 O(1) 实现，作为差分验证的候选引擎
+ *
+ * 原实现每次缺页整表找 victim、每次周期扫描整表清引用位。这里把工作集中的页按引用位分成两条链表，
+ * 每条链表都按 age 从小到大排列：
+ *  - 命中或装入的页 age 最新、引用位为1，移到"已引用"链表尾部
+ *  - 周期扫描把所有引用位清零，等价于把"已引用"链表整体接到"未引用"链表尾部
+ *    (未引用链表中的页都是上次扫描前访问的，age 一定更小，拼接后仍然有序)
+ *  - victim 是未引用链表的头(未引用页中 age 最小)；为空时是已引用链表的头(所有页中 age 最小)
+ * 每进程的 age 各不相同，所以与原实现选出的 victim 完全一致。摘链不需要知道页在哪条链表上，
+ * 引用位也就不必单独保存，周期扫描只是一次拼接
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "bench_engine.h"
+
+/*
+ * 每进程的双向链表：下标 0..page_count-1 为页，page_count 与 page_count+1 为两条链表的哨兵
+ */
+typedef struct WSClockFastProc {
+    int page_count;
+    int working_set_size;
+    int ws_count;
+    int* next;
+    int* prev;
+    unsigned char* in_ws; /* 页是否在工作集中(在两条链表之一上) */
+} WSClockFastProc;
+
+typedef struct WSClockFastEngineState {
+    WSClockFastProc* procs;
+    int process_count;
+    int scan_period;
+    unsigned long refs;
+} WSClockFastEngineState;
+
+static void fast_unlink(WSClockFastProc* p, int i)
+{
+    p->next[p->prev[i]] = p->next[i];
+    p->prev[p->next[i]] = p->prev[i];
+}
+
+static void fast_push_tail(WSClockFastProc* p, int head, int i)
+{
+    int last = p->prev[head];
+    p->next[last] = i;
+    p->prev[i] = last;
+    p->next[i] = head;
+    p->prev[head] = i;
+}
+
+/* 把已引用链表整体接到未引用链表尾部 */
+static void fast_clear_referenced(WSClockFastProc* p)
+{
+    int u = p->page_count;
+    int r = p->page_count + 1;
+    if (p->next[r] == r) return;
+    int first = p->next[r];
+    int last = p->prev[r];
+    int tail = p->prev[u];
+    p->next[tail] = first;
+    p->prev[first] = tail;
+    p->next[last] = u;
+    p->prev[u] = last;
+    p->next[r] = r;
+    p->prev[r] = r;
+}
+
+static int wsclock_fast_engine_access(ReplayEngine* engine, int process_index, int page_id)
+{
+    WSClockFastEngineState* st = (WSClockFastEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->process_count) return -1;
+    WSClockFastProc* p = &st->procs[process_index];
+    if (page_id < 0 || page_id >= p->page_count) return -1;
+
+    int u = p->page_count;
+    int r = p->page_count + 1;
+    int fault = !p->in_ws[page_id];
+    if (!fault) {
+        fast_unlink(p, page_id);
+    } else {
+        if (p->ws_count >= p->working_set_size && p->ws_count > 0) {
+            int victim = p->next[u] != u ? p->next[u] : p->next[r];
+            fast_unlink(p, victim);
+            p->in_ws[victim] = 0;
+            p->ws_count--;
+            engine->scanned++;
+            engine->evictions++;
+        }
+        p->in_ws[page_id] = 1;
+        p->ws_count++;
+    }
+    fast_push_tail(p, r, page_id);
+
+    /* 与 WSClock 引擎相同的扫描节奏 */
+    st->refs++;
+    if (st->scan_period > 0 && st->refs % (unsigned long)st->scan_period == 0) {
+        for (int i = 0; i < st->process_count; i++) {
+            fast_clear_referenced(&st->procs[i]);
+            engine->scanned++;
+        }
+    }
+    return fault;
+}
+
+static int wsclock_fast_engine_resident(ReplayEngine* engine, int process_index, unsigned long long* bits, int words)
+{
+    WSClockFastEngineState* st = (WSClockFastEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->process_count) return -1;
+    const WSClockFastProc* p = &st->procs[process_index];
+    memset(bits, 0, sizeof(unsigned long long) * (size_t)words);
+    for (int i = 0; i < p->page_count && i / 64 < words; i++) {
+        if (p->in_ws[i]) bits[i / 64] |= 1ULL << (i % 64);
+    }
+    return p->ws_count;
+}
+
+static void wsclock_fast_engine_destroy(ReplayEngine* engine)
+{
+    WSClockFastEngineState* st = (WSClockFastEngineState*)engine->state;
+    if (!st) return;
+    for (int i = 0; st->procs && i < st->process_count; i++) {
+        free(st->procs[i].next);
+        free(st->procs[i].prev);
+        free(st->procs[i].in_ws);
+    }
+    free(st->procs);
+    free(st);
+    engine->state = 0;
+}
+
+int engine_wsclock_fast_create(ReplayEngine* engine, const EngineConfig* config)
+{
+    WSClockFastEngineState* st = (WSClockFastEngineState*)calloc(1, sizeof(WSClockFastEngineState));
+    if (!st) return -1;
+    st->process_count = config->process_count;
+    st->scan_period = config->scan_period;
+    st->procs = (WSClockFastProc*)calloc((size_t)config->process_count, sizeof(WSClockFastProc));
+    int ok = st->procs != 0;
+    for (int i = 0; ok && i < config->process_count; i++) {
+        WSClockFastProc* p = &st->procs[i];
+        size_t n = (size_t)config->page_count + 2;
+        p->page_count = config->page_count;
+        p->working_set_size = config->working_set_size;
+        p->next = (int*)malloc(sizeof(int) * n);
+        p->prev = (int*)malloc(sizeof(int) * n);
+        p->in_ws = (unsigned char*)calloc(n, 1);
+        ok = p->next && p->prev && p->in_ws;
+        for (int h = config->page_count; ok && h < config->page_count + 2; h++) {
+            p->next[h] = h;
+            p->prev[h] = h;
+        }
+    }
+    engine->state = st;
+    if (!ok) {
+        wsclock_fast_engine_destroy(engine);
+        return -1;
+    }
+
+    engine->name = "WSClock-O1";
+    engine->has_scan_work = 1;
+    engine->access = wsclock_fast_engine_access;
+    engine->resident = wsclock_fast_engine_resident;
+    engine->destroy = wsclock_fast_engine_destroy;
+    return 0;
+}
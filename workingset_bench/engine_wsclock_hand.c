@@ -0,0 +1,123 @@
+/*
+ * WSClock_1(时钟指针版本)引擎适配
+ * 与 WSClock 的实现同名，包含前先把对外函数改名，避免链接冲突
+ */
+#define wsclock_init          wsclock1_init
+#define wsclock_access_page   wsclock1_access_page
+#define wsclock_periodic_scan wsclock1_periodic_scan
+#define wsclock_cleanup       wsclock1_cleanup
+#include "../WSClock_1/wsclock_kernel.c"
+
+#include <stdlib.h>
+#include <string.h>
+#include "bench_engine.h"
+
+typedef struct WSClockHandEngineState {
+    WSClockEnvironment env;
+    Process* procs;
+    int scan_period;
+    unsigned long refs;
+} WSClockHandEngineState;
+
+/* 工作集中的页数(WSClock_1 不维护计数，统计开销不计入扫描量) */
+static int wsclock_hand_engine_ws_count(const Process* proc)
+{
+    int count = 0;
+    for (int i = 0; i < proc->page_count; i++) {
+        count += proc->page_table[i].in_working_set ? 1 : 0;
+    }
+    return count;
+}
+
+static int wsclock_hand_engine_access(ReplayEngine* engine, int process_index, int page_id)
+{
+    WSClockHandEngineState* st = (WSClockHandEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->env.process_count) return -1;
+    Process* proc = &st->procs[process_index];
+    if (page_id < 0 || page_id >= proc->page_count) return -1;
+
+    int fault = !proc->page_table[page_id].in_working_set;
+    int before = fault ? wsclock_hand_engine_ws_count(proc) : 0;
+    int hand = proc->clock_hand;
+    wsclock_access_page(&st->env, process_index, page_id);
+    if (fault && before >= proc->working_set_size) {
+        /* 时钟指针走过的页数；找到 victim 时指针停在 victim 上，找不到时走满一圈 */
+        if (wsclock_hand_engine_ws_count(proc) == before) {
+            int n = proc->page_count;
+            engine->scanned += (unsigned long long)((proc->clock_hand - hand + n) % n + 1);
+            engine->evictions++;
+        } else {
+            engine->scanned += (unsigned long long)proc->page_count;
+        }
+    }
+
+    st->refs++;
+    if (st->scan_period > 0 && st->refs % (unsigned long)st->scan_period == 0) {
+        for (int i = 0; i < st->env.process_count; i++) {
+            wsclock_periodic_scan(&st->env, i);
+            engine->scanned += (unsigned long long)st->procs[i].page_count;
+        }
+    }
+    return fault;
+}
+
+static int wsclock_hand_engine_resident(ReplayEngine* engine, int process_index, unsigned long long* bits, int words)
+{
+    WSClockHandEngineState* st = (WSClockHandEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->env.process_count) return -1;
+    const Process* proc = &st->procs[process_index];
+    int count = 0;
+    memset(bits, 0, sizeof(unsigned long long) * (size_t)words);
+    for (int i = 0; i < proc->page_count && i / 64 < words; i++) {
+        if (proc->page_table[i].in_working_set) {
+            bits[i / 64] |= 1ULL << (i % 64);
+            count++;
+        }
+    }
+    return count;
+}
+
+static void wsclock_hand_engine_destroy(ReplayEngine* engine)
+{
+    WSClockHandEngineState* st = (WSClockHandEngineState*)engine->state;
+    if (!st) return;
+    wsclock_cleanup(&st->env);
+    for (int i = 0; i < st->env.process_count; i++) {
+        free(st->procs[i].page_table);
+    }
+    free(st->procs);
+    free(st);
+    engine->state = 0;
+}
+
+int engine_wsclock_hand_create(ReplayEngine* engine, const EngineConfig* config)
+{
+    WSClockHandEngineState* st = (WSClockHandEngineState*)calloc(1, sizeof(WSClockHandEngineState));
+    if (!st) return -1;
+    st->procs = (Process*)calloc((size_t)config->process_count, sizeof(Process));
+    if (!st->procs) {
+        free(st);
+        return -1;
+    }
+    for (int i = 0; i < config->process_count; i++) {
+        Process* p = &st->procs[i];
+        p->process_id = i;
+        p->page_count = config->page_count;
+        p->working_set_size = config->working_set_size;
+        p->active = 1;
+        p->page_table = (Page*)calloc((size_t)config->page_count, sizeof(Page));
+        for (int j = 0; p->page_table && j < config->page_count; j++) {
+            p->page_table[j].page_id = j;
+        }
+    }
+    wsclock_init(&st->env, st->procs, config->process_count, 0);
+    st->scan_period = config->scan_period;
+
+    engine->name = "WSClock_1";
+    engine->state = st;
+    engine->has_scan_work = 1;
+    engine->access = wsclock_hand_engine_access;
+    engine->resident = wsclock_hand_engine_resident;
+    engine->destroy = wsclock_hand_engine_destroy;
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * WSClock_1(时钟指针版本)的位图实现，作为差分验证的候选引擎
+ *
+ * 原实现每次缺页都整表统计工作集页数，时钟指针逐项走过不在工作集中的页，周期扫描也整表清引用位。
+ * 这里维护工作集计数和工作集位图：指针一次跳过整段不在工作集中的页(扫描计数照样累加，
+ * 走满一圈找不到 victim 时指针停在与原实现相同的位置)，周期扫描只访问工作集中的页。
+ * 引用位、时间戳、修改位与老化阈值的处理与原实现逐项相同
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "bench_engine.h"
+
+#define HAND_FAST_OLD_THRESHOLD  5   /* 与 WSClock_1 的 oldThreshold 相同 */
+#define HAND_FAST_MAX_WRITES     2   /* 与 WSClock_1 的 maxWritesPerScan 相同 */
+
+typedef struct HandFastPage {
+    unsigned long age;
+    unsigned char referenced;
+    unsigned char modified;
+} HandFastPage;
+
+typedef struct HandFastProc {
+    int page_count;
+    int working_set_size;
+    int ws_count;
+    int clock_hand;
+    unsigned long clock;
+    HandFastPage* pages;
+    unsigned long long* bits;  /* 工作集位图 */
+} HandFastProc;
+
+typedef struct HandFastEngineState {
+    HandFastProc* procs;
+    int process_count;
+    int words;
+    int scan_period;
+    unsigned long refs;
+} HandFastEngineState;
+
+/* [from, limit) 中第一个在工作集中的页，没有时返回 limit */
+static int hand_fast_next(const HandFastProc* p, int from, int limit)
+{
+    int w = from / 64;
+    unsigned long long word = p->bits[w] & (~0ULL << (from % 64));
+    while (!word) {
+        if (++w * 64 >= limit) return limit;
+        word = p->bits[w];
+    }
+    int i = w * 64 + __builtin_ctzll(word);
+    return i < limit ? i : limit;
+}
+
+/* 与 WSClock_1 的 find_victim_page 相同的指针走法；返回 victim 页号，走满一圈没有时返回 -1 */
+static int hand_fast_find_victim(HandFastProc* p, unsigned long long* scanned)
+{
+    int n = p->page_count;
+    int scan_count = 0;
+    int writes = 0;
+    if (p->clock_hand >= n) p->clock_hand = 0;
+
+    while (scan_count < n) {
+        int j = hand_fast_next(p, p->clock_hand, n);
+        int skip = j - p->clock_hand;
+        if (scan_count + skip >= n) {
+            /* 剩余的步数都落在不在工作集中的页上 */
+            p->clock_hand = (p->clock_hand + (n - scan_count)) % n;
+            return -1;
+        }
+        scan_count += skip;
+        if (j == n) {
+            p->clock_hand = 0;
+            continue;
+        }
+        p->clock_hand = j;
+        (*scanned)++;
+
+        HandFastPage* page = &p->pages[j];
+        if (page->referenced) {
+            page->referenced = 0;
+        } else if (p->clock - page->age >= HAND_FAST_OLD_THRESHOLD) {
+            if (!page->modified) return j;
+            if (writes < HAND_FAST_MAX_WRITES) {
+                writes++;
+                page->modified = 0;
+                return j;
+            }
+        }
+        p->clock_hand = (p->clock_hand + 1) % n;
+        scan_count++;
+    }
+    return -1;
+}
+
+static int hand_fast_engine_access(ReplayEngine* engine, int process_index, int page_id)
+{
+    HandFastEngineState* st = (HandFastEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->process_count) return -1;
+    HandFastProc* p = &st->procs[process_index];
+    if (page_id < 0 || page_id >= p->page_count) return -1;
+
+    p->clock++;
+    HandFastPage* page = &p->pages[page_id];
+    unsigned long long mask = 1ULL << (page_id % 64);
+    int fault = !(p->bits[page_id / 64] & mask);
+    if (fault) {
+        if (p->ws_count >= p->working_set_size) {
+            int victim = hand_fast_find_victim(p, &engine->scanned);
+            if (victim >= 0) {
+                HandFastPage* v = &p->pages[victim];
+                v->referenced = 0;
+                v->age = 0;
+                v->modified = 0;
+                p->bits[victim / 64] &= ~(1ULL << (victim % 64));
+                p->ws_count--;
+                engine->evictions++;
+            }
+        }
+        p->bits[page_id / 64] |= mask;
+        p->ws_count++;
+        page->modified = 0;
+    }
+    page->referenced = 1;
+    page->age = p->clock;
+
+    st->refs++;
+    if (st->scan_period > 0 && st->refs % (unsigned long)st->scan_period == 0) {
+        for (int i = 0; i < st->process_count; i++) {
+            HandFastProc* q = &st->procs[i];
+            for (int w = 0; w < st->words; w++) {
+                for (unsigned long long b = q->bits[w]; b; b &= b - 1) {
+                    q->pages[w * 64 + __builtin_ctzll(b)].referenced = 0;
+                    engine->scanned++;
+                }
+            }
+        }
+    }
+    return fault;
+}
+
+static int hand_fast_engine_resident(ReplayEngine* engine, int process_index, unsigned long long* bits, int words)
+{
+    HandFastEngineState* st = (HandFastEngineState*)engine->state;
+    if (process_index < 0 || process_index >= st->process_count) return -1;
+    const HandFastProc* p = &st->procs[process_index];
+    int n = words < st->words ? words : st->words;
+    memset(bits, 0, sizeof(unsigned long long) * (size_t)words);
+    memcpy(bits, p->bits, sizeof(unsigned long long) * (size_t)n);
+    return p->ws_count;
+}
+
+static void hand_fast_engine_destroy(ReplayEngine* engine)
+{
+    HandFastEngineState* st = (HandFastEngineState*)engine->state;
+    if (!st) return;
+    for (int i = 0; st->procs && i < st->process_count; i++) {
+        free(st->procs[i].pages);
+        free(st->procs[i].bits);
+    }
+    free(st->procs);
+    free(st);
+    engine->state = 0;
+}
+
+int engine_wsclock_hand_fast_create(ReplayEngine* engine, const EngineConfig* config)
+{
+    HandFastEngineState* st = (HandFastEngineState*)calloc(1, sizeof(HandFastEngineState));
+    if (!st) return -1;
+    st->process_count = config->process_count;
+    st->words = (config->page_count + 63) / 64;
+    st->scan_period = config->scan_period;
+    st->procs = (HandFastProc*)calloc((size_t)config->process_count, sizeof(HandFastProc));
+    int ok = st->procs != 0;
+    for (int i = 0; ok && i < config->process_count; i++) {
+        HandFastProc* p = &st->procs[i];
+        p->page_count = config->page_count;
+        p->working_set_size = config->working_set_size;
+        p->pages = (HandFastPage*)calloc((size_t)config->page_count, sizeof(HandFastPage));
+        p->bits = (unsigned long long*)calloc((size_t)st->words, sizeof(unsigned long long));
+        ok = p->pages && p->bits;
+    }
+    engine->state = st;
+    if (!ok) {
+        hand_fast_engine_destroy(engine);
+        return -1;
+    }
+
+    engine->name = "WSClock_1-bm";
+    engine->has_scan_work = 1;
+    engine->access = hand_fast_engine_access;
+    engine->resident = hand_fast_engine_resident;
+    engine->destroy = hand_fast_engine_destroy;
+    return 0;
+}